@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace Fixpp
 {
 
@@ -35,16 +37,58 @@ namespace Fixpp
                 return value[0] == C1 && value[1] == C2;
             }
         };
+
+        // Every MsgType character is alphanumeric, which means that a character
+        // can be packed on 6 bits, 0 being reserved for "no character".
+        //
+        // A MsgType of one or two characters can then be packed into a 12 bits key,
+        // which is used to index the MsgType dispatch table of a Dictionary
+
+        static constexpr size_t KeyBits = 6;
+        static constexpr size_t KeySize = 1 << (KeyBits * 2);
+
+        constexpr unsigned pack(char c)
+        {
+            return c >= '0' && c <= '9' ? static_cast<unsigned>(c - '0') + 1 :
+                   c >= 'A' && c <= 'Z' ? static_cast<unsigned>(c - 'A') + 11 :
+                   c >= 'a' && c <= 'z' ? static_cast<unsigned>(c - 'a') + 37 : 0;
+        }
+
+        // Returns 0 if the MsgType can not be packed
+        inline unsigned key(const char* value, size_t len)
+        {
+            if (len == 1)
+                return pack(value[0]) << KeyBits;
+
+            if (len == 2)
+            {
+                const auto c1 = pack(value[0]);
+                const auto c2 = pack(value[1]);
+                return (c1 && c2) ? (c1 << KeyBits) | c2 : 0;
+            }
+
+            return 0;
+        }
     };
 
     template<char... Cs> struct Chars
     {
 
         static constexpr size_t Size = sizeof...(Cs);
-        static_assert(Size <= 2, "Too many characters");
 
         static constexpr const char Value[] = { Cs... };
 
+        // A Key packs at most two characters: a longer MsgType could not be told apart
+        // from the MsgType made of its first and last characters in the dispatch table
+        static_assert(Size <= 2, "A MsgType can only be made of one or two characters to be packed into a Key");
+
+        static constexpr unsigned Key = Size == 1 ?
+            char_traits::pack(Value[0]) << char_traits::KeyBits :
+            (char_traits::pack(Value[0]) << char_traits::KeyBits) | char_traits::pack(Value[Size - 1]);
+
+        static_assert(char_traits::pack(Value[0]) != 0 && char_traits::pack(Value[Size - 1]) != 0,
+                      "MsgType characters must be alphanumeric");
+
         static bool equals(const char* msgType, size_t len)
         {
             if (len != Size)
@@ -60,6 +104,9 @@ namespace Fixpp
     template<char... Cs>
     constexpr size_t Chars<Cs...>::Size;
 
+    template<char... Cs>
+    constexpr unsigned Chars<Cs...>::Key;
+
     template<> struct Chars<>
     {
     };
@@ -1,9 +1,15 @@
 #pragma once
 
-#include <cmath>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include <fixpp/tag.h>
-#include <fixpp/utils/cursor.h>
+#include <fixpp/utils/swar.h>
 #include <fixpp/utils/time.h>
 
 namespace Fixpp
@@ -42,54 +48,92 @@ namespace Fixpp
         template<>
         struct LexicalCast<Type::Int>
         {
-            static int64_t cast(const char* offset, size_t /*size*/)
+            static int64_t cast(const char* offset, size_t size)
             {
-                int64_t x = 0;
+                const char* first = offset;
+                const char* last = offset + size;
+
                 bool neg = false;
-                if (*offset == '-') {
+                if (first != last && *first == '-') {
                     neg = true;
-                    ++offset;
-                }
-                while (*offset >= '0' && *offset <= '9') {
-                    x = (x*10) + (*offset - '0');
-                    ++offset;
+                    ++first;
                 }
-                if (neg) {
-                    x = -x;
-                }
-                return x;
+
+                // The magnitude of INT64_MIN is one past INT64_MAX
+                const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + neg;
+
+                uint64_t x = 0;
+                if (swar::parseUnsigned(first, last, max, &x) == 0)
+                    return 0;
+
+                return neg ? static_cast<int64_t>(0 - x) : static_cast<int64_t>(x);
             }
         };
 
+        // Decimals are parsed into a 64-bit integer mantissa and a power of ten. When both
+        // the mantissa (at most 2^53) and the power of ten (at most 10^22) are exactly
+        // representable as a double, a single division gives the correctly rounded
+        // result. Other values, with more than 15 significant digits, are handed to
+        // std::from_chars
+
         template<>
         struct LexicalCast<Type::Float>
         {
-            static double cast(const char* offset, size_t /*size*/)
+            static double cast(const char* offset, size_t size)
             {
-                double r = 0.0;
+                static constexpr double Powers[] = {
+                    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+
+                static constexpr uint64_t MaxExactMantissa = uint64_t(1) << 53;
+                static constexpr size_t MaxDigits = 19;
+
+                const char* first = offset;
+                const char* last = offset + size;
+
+                const char* p = first;
+
                 bool neg = false;
-                if (*offset == '-') {
+                if (p != last && *p == '-') {
                     neg = true;
-                    ++offset;
-                }
-                while (*offset >= '0' && *offset <= '9') {
-                    r = (r*10.0) + (*offset - '0');
-                    ++offset;
+                    ++p;
                 }
-                if (*offset == '.') {
-                    double f = 0.0;
-                    int n = 0;
-                    ++offset;
-                    while (*offset >= '0' && *offset <= '9') {
-                        f = (f*10.0) + (*offset - '0');
-                        ++offset;
-                        ++n;
+
+                // Leading zeros are not significant
+                while (p != last && *p == '0')
+                    ++p;
+
+                uint64_t mantissa = 0;
+                size_t digits = 0;
+                p = swar::parseDigits(p, last, mantissa, digits);
+
+                size_t decimals = 0;
+                if (p != last && *p == '.') {
+                    ++p;
+
+                    const char* fraction = p;
+                    if (mantissa == 0) {
+                        while (p != last && *p == '0')
+                            ++p;
                     }
-                    r += f / std::pow(10.0, n);
-                }
-                if (neg) {
-                    r = -r;
+
+                    p = swar::parseDigits(p, last, mantissa, digits);
+                    decimals = static_cast<size_t>(p - fraction);
                 }
+
+                if (digits > MaxDigits || mantissa > MaxExactMantissa || decimals >= sizeof Powers / sizeof *Powers)
+                    return slowCast(first, p);
+
+                const double r = static_cast<double>(mantissa) / Powers[decimals];
+                return neg ? -r : r;
+            }
+
+        private:
+            static double slowCast(const char* first, const char* last)
+            {
+                double r = 0.0;
+                std::from_chars(first, last, r);
                 return r;
             }
         };
@@ -112,153 +156,253 @@ namespace Fixpp
             }
         };
 
+        // Values read through a FieldRef, from the frame a message has been parsed from.
+        // String-like values are returned as views on the frame instead of copies.
+        // tryCast() returns false for malformed values of the types that tell them apart,
+        // like the time types, and always succeeds for the others
+
+        template<typename T>
+        struct RefCast : public LexicalCast<T>
+        {
+            using StorageType = typename T::StorageType;
+            using UnderlyingType = typename T::UnderlyingType;
+
+            static bool tryCast(const char* offset, size_t size, StorageType* value)
+            {
+                return doTryCast(offset, size, value, 0);
+            }
+
+        private:
+            template<typename Cast = LexicalCast<T>>
+            static auto doTryCast(const char* offset, size_t size, StorageType* value, int)
+                -> decltype(Cast::tryCast(offset, size, value))
+            {
+                return Cast::tryCast(offset, size, value);
+            }
+
+            static bool doTryCast(const char* offset, size_t size, StorageType* value, long)
+            {
+                *value = LexicalCast<T>::cast(offset, size);
+                return true;
+            }
+        };
+
         template<>
-        struct LexicalCast<Type::UTCTimestamp>
+        struct RefCast<Type::String>
         {
-            static Type::UTCTimestamp::Time cast(const char* offset, size_t size)
+            using StorageType = std::string_view;
+            using UnderlyingType = std::string_view;
+
+            static std::string_view cast(const char* offset, size_t size)
             {
-                RawStreamBuf<> buf(const_cast<char *>(offset), size);
-                StreamCursor cursor(&buf);
+                return {offset, size};
+            }
 
-                const auto parseFragment = [&](size_t size, const char* error)
-                {
-                    int value;
-                    if (!match_int_fast_n(&value, cursor, size))
-                        throw std::runtime_error(error);
-                    return value;
-                };
+            static bool tryCast(const char* offset, size_t size, std::string_view* value)
+            {
+                *value = cast(offset, size);
+                return true;
+            }
+        };
 
-                const int year  = parseFragment(4, "Could not parse year from UTCTimestamp");
-                const int month = parseFragment(2, "Could not parse month from UTCTimestamp");
-                const int day   = parseFragment(2, "Could not parse month from UTCTimestamp");
+        template<>
+        struct RefCast<Type::Data> : public RefCast<Type::String>
+        {
+        };
 
-                // Literal('-')
-                if (!cursor.advance(1))
-                    throw std::runtime_error("Could not parse hour from UTCTimestamp, expected '-' got EOF");
+        // Decoders for the fixed-width layouts of the time types. Every component is
+        // validated, 8 bytes at a time, and converted through closed-form arithmetic.
+        // Decoders return false on malformed values instead of throwing
 
-                const int hour = parseFragment(2, "Could not parse hours from UTCTimestamp");
-                //
-                // Literal(':')
-                if (!cursor.advance(1))
-                    throw std::runtime_error("Could not parse minutes from UTCTimestamp, expected ':' got EOF");
+        namespace utc
+        {
 
-                const int min = parseFragment(2, "Could not parse minutes from UTCTimestamp");
-                //
-                // Literal(':')
-                if (!cursor.advance(1))
-                    throw std::runtime_error("Could not parse seconds from UTCTimestamp, expected ':' got EOF");
+            static constexpr int64_t SecondsPerDay = 86400;
 
-                const int sec = parseFragment(2, "Could not parse seconds from UTCTimestamp");
+            // Decodes YYYYMMDD into a number of seconds since the Epoch
+            inline bool decodeDate(const char* offset, int64_t* secs)
+            {
+                const uint64_t chunk = swar::load8(offset);
+                if (!swar::isDigits8(chunk))
+                    return false;
 
-                std::optional<int> msec;
-                if (!cursor.eof())
-                {
-                    // Literal('.')
-                    cursor.advance(1);
-                    msec = parseFragment(3, "Could not parse milliseconds from UTCTimestamp");
-                }
+                const uint32_t value = swar::parse8(chunk);
 
-                std::optional<int> usec;
-                if (!cursor.eof())
-                {
-                    usec = parseFragment(3, "Could not parse microseconds from UTCTimeOnly");
-                }
+                const int year = static_cast<int>(value / 10000);
+                const unsigned month = value / 100 % 100;
+                const unsigned day = value % 100;
+
+                if (month < 1 || month > 12 || day < 1 || day > civil::daysInMonth(year, month))
+                    return false;
 
-                std::tm tm{};
-                // tm_year is year since 1900
-                tm.tm_year = year - 1900;
-                // tm_mon is 0-indexed
-                tm.tm_mon = month - 1;
-                tm.tm_mday = day;
-                tm.tm_hour = hour;
-                tm.tm_min = min;
-                tm.tm_sec = sec;
-
-                return {mkgmtime(&tm), msec, usec};
+                *secs = civil::daysFromCivil(year, month, day) * SecondsPerDay;
+                return true;
             }
-        };
 
-        template<>
-        struct LexicalCast<Type::UTCDate>
-        {
-            static Type::UTCDate::Date cast(const char* offset, size_t size)
+            // Decodes HH:MM:SS into a number of seconds since midnight
+            inline bool decodeTimeOfDay(const char* offset, int64_t* secs)
             {
-                RawStreamBuf<> buf(const_cast<char *>(offset), size);
-                StreamCursor cursor(&buf);
+                static constexpr uint64_t Colons = 0x00003A00003A0000ULL;
+                static constexpr uint64_t ColonsMask = 0x0000FF0000FF0000ULL;
+                static constexpr uint64_t Zeros = 0x0000300000300000ULL;
 
-                const auto parseFragment = [&](size_t size, const char* error)
-                {
-                    int value;
-                    if (!match_int_fast_n(&value, cursor, size))
-                        throw std::runtime_error(error);
-                    return value;
-                };
+                const uint64_t chunk = swar::load8(offset);
+                if ((chunk & ColonsMask) != Colons)
+                    return false;
+
+                // HH0MM0SS
+                const uint64_t digits = (chunk & ~ColonsMask) | Zeros;
+                if (!swar::isDigits8(digits))
+                    return false;
+
+                const uint32_t value = swar::parse8(digits);
 
-                const int year  = parseFragment(4, "Could not parse year from UTCDate");
-                const int month = parseFragment(2, "Could not parse month from UTCDate");
-                const int day   = parseFragment(2, "Could not parse month from UTCDate");
+                const unsigned hour = value / 1000000;
+                const unsigned min = value / 1000 % 100;
+                const unsigned sec = value % 100;
 
-                std::tm tm{};
-                // tm_year is year since 1900
-                tm.tm_year = year - 1900;
-                // tm_mon is 0-indexed
-                tm.tm_mon = month - 1;
-                tm.tm_mday = day;
+                // 60 is a leap second
+                if (hour > 23 || min > 59 || sec > 60)
+                    return false;
 
-                return {mkgmtime(&tm)};
+                *secs = hour * 3600 + min * 60 + sec;
+                return true;
             }
-        };
 
-        template<>
-        struct LexicalCast<Type::UTCTimeOnly>
-        {
-            static Type::UTCTimeOnly::Time cast(const char* offset, size_t size)
+            // Decodes the optional .sss, .ssssss, .sssssssss or .ssssssssssss fraction of a time
+            // into a number of nanoseconds and the number of digits it has been written with.
+            // Picoseconds, as sent by some FIX 5.0SP2 venues, are truncated to nanoseconds
+            inline bool decodeFraction(const char* offset, size_t size, int64_t* nanos, size_t* digits)
             {
-                RawStreamBuf<> buf(const_cast<char *>(offset), size);
-                StreamCursor cursor(&buf);
+                static constexpr int64_t Scales[] = { 1000000, 1000, 1 };
 
-                const auto parseFragment = [&](size_t size, const char* error)
-                {
-                    int value;
-                    if (!match_int_fast_n(&value, cursor, size))
-                        throw std::runtime_error(error);
-                    return value;
-                };
+                *nanos = 0;
+                *digits = 0;
 
-                const int hour = parseFragment(2, "Could not parse hours from UTCTimeOnly");
-                //
-                // Literal(':')
-                if (!cursor.advance(1))
-                    throw std::runtime_error("Could not parse minutes from UTCTimeOnly, expected ':' got EOF");
+                if (size == 0)
+                    return true;
 
-                const int min = parseFragment(2, "Could not parse minutes from UTCTimeOnly");
-                //
-                // Literal(':')
-                if (!cursor.advance(1))
-                    throw std::runtime_error("Could not parse seconds from UTCTimeOnly, expected ':' got EOF");
+                if ((size != 4 && size != 7 && size != 10 && size != 13) || offset[0] != '.')
+                    return false;
 
-                const int sec = parseFragment(2, "Could not parse seconds from UTCTimeOnly");
+                uint64_t value = 0;
+                if (swar::parseDigits(offset + 1, offset + size, value, *digits) != offset + size)
+                    return false;
 
-                std::optional<int> msec;
-                if (!cursor.eof())
+                if (*digits == 12)
                 {
-                    // Literal('.')
-                    cursor.advance(1);
-                    msec = parseFragment(3, "Could not parse milliseconds from UTCTimeOnly");
+                    value /= 1000;
+                    *digits = 9;
                 }
 
-                std::optional<int> usec;
-                if (!cursor.eof())
-                {
-                    usec = parseFragment(3, "Could not parse microseconds from UTCTimeOnly");
-                }
+                *nanos = static_cast<int64_t>(value) * Scales[*digits / 3 - 1];
+                return true;
+            }
+
+        } // namespace utc
+
+        // Malformed time values are reported by tryCast() without throwing. cast() is the
+        // unchecked path of get() and throws rather than handing back a valid-looking time
+
+        template<>
+        struct LexicalCast<Type::UTCTimestamp>
+        {
+            // YYYYMMDD-HH:MM:SS
+            static constexpr size_t Size = 17;
+
+            static bool tryCast(const char* offset, size_t size, Type::UTCTimestamp::Time* value)
+            {
+                if (size < Size || offset[8] != '-')
+                    return false;
+
+                int64_t date, time;
+                if (!utc::decodeDate(offset, &date) || !utc::decodeTimeOfDay(offset + 9, &time))
+                    return false;
+
+                int64_t nanos;
+                size_t digits;
+                if (!utc::decodeFraction(offset + Size, size - Size, &nanos, &digits))
+                    return false;
+
+                // Timestamps past 2262, like the 99991231-23:59:59 "never expires" sentinel, do
+                // not fit in nanoseconds. They are not saturated but reported as an error:
+                // tryCast() returns false and cast(), hence get(), throws
+                const int64_t secs = date + time;
+                if (!Type::UTCTimestamp::Time::inRange(secs))
+                    return false;
+
+                *value = Type::UTCTimestamp::Time::fromNanoseconds(secs * Type::UTCTimestamp::Time::NanosPerSecond + nanos, static_cast<unsigned>(digits));
+                return true;
+            }
+
+            static Type::UTCTimestamp::Time cast(const char* offset, size_t size)
+            {
+                Type::UTCTimestamp::Time value(0);
+                if (!tryCast(offset, size, &value))
+                    throw std::runtime_error("Malformed or out of range UTCTimestamp '" + std::string(offset, size) + "'");
+                return value;
+            }
+        };
+
+        template<>
+        struct LexicalCast<Type::UTCDate>
+        {
+            // YYYYMMDD
+            static constexpr size_t Size = 8;
+
+            static bool tryCast(const char* offset, size_t size, Type::UTCDate::Date* value)
+            {
+                int64_t date;
+                if (size != Size || !utc::decodeDate(offset, &date))
+                    return false;
+
+                *value = Type::UTCDate::Date(static_cast<std::time_t>(date));
+                return true;
+            }
+
+            static Type::UTCDate::Date cast(const char* offset, size_t size)
+            {
+                Type::UTCDate::Date value(0);
+                if (!tryCast(offset, size, &value))
+                    throw std::runtime_error("Could not parse UTCDate '" + std::string(offset, size) + "'");
+                return value;
+            }
+        };
+
+        template<>
+        struct LexicalCast<Type::UTCTimeOnly>
+        {
+            // HH:MM:SS
+            static constexpr size_t Size = 8;
 
-                std::tm tm{};
-                tm.tm_hour = hour;
-                tm.tm_min = min;
-                tm.tm_sec = sec;
+            static bool tryCast(const char* offset, size_t size, Type::UTCTimeOnly::Time* value)
+            {
+                int64_t time;
+                if (size < Size || !utc::decodeTimeOfDay(offset, &time))
+                    return false;
+
+                // UTCTimeOnly is only precise up to the microsecond
+                int64_t nanos;
+                size_t digits;
+                if (!utc::decodeFraction(offset + Size, size - Size, &nanos, &digits) || digits > 6)
+                    return false;
+
+                std::optional<int> msec, usec;
+                if (digits >= 3)
+                    msec = static_cast<int>(nanos / 1000000);
+                if (digits >= 6)
+                    usec = static_cast<int>(nanos / 1000 % 1000);
+
+                *value = Type::UTCTimeOnly::Time(static_cast<std::time_t>(time), msec, usec);
+                return true;
+            }
 
-                return {mkgmtime(&tm), msec, usec};
+            static Type::UTCTimeOnly::Time cast(const char* offset, size_t size)
+            {
+                Type::UTCTimeOnly::Time value(0);
+                if (!tryCast(offset, size, &value))
+                    throw std::runtime_error("Could not parse UTCTimeOnly '" + std::string(offset, size) + "'");
+                return value;
             }
         };
 
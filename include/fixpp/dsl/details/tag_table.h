@@ -0,0 +1,203 @@
+/* tag_table.h
+
+   A compile-time lookup table that maps a tag to its index inside
+   a Message or a RepeatingGroup.
+
+   Tags are looked up on every single field of a frame, so the lookup must
+   not depend on the number of fields of the Message. The table is split
+   in two parts:
+
+   - A dense part that directly maps a tag to its index. Standard FIX tags
+     are small and packed together, which keeps this part reasonably small.
+
+   - A sparse part for tags that are too large to be held by the dense part
+     (custom tags, usually). Those are stored inside a perfect hash table
+     whose parameters are found at compile-time.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fixpp
+{
+
+    namespace details
+    {
+
+        namespace tag_table
+        {
+
+            // Tags up to DenseLimit are held by the dense part of the table
+            static constexpr unsigned DenseLimit = 4096;
+
+            template<size_t Size>
+            struct Keys
+            {
+                unsigned tags[Size ? Size : 1];
+            };
+
+            // Returns the largest tag in [0, limit)
+            template<size_t Size>
+            constexpr unsigned maxBelow(const Keys<Size>& keys, unsigned limit)
+            {
+                unsigned max = 0;
+                for (size_t i = 0; i < Size; ++i)
+                {
+                    if (keys.tags[i] < limit && keys.tags[i] > max)
+                        max = keys.tags[i];
+                }
+                return max;
+            }
+
+            // Returns the number of distinct tags that are >= limit
+            template<size_t Size>
+            constexpr size_t countAbove(const Keys<Size>& keys, unsigned limit)
+            {
+                size_t count = 0;
+                for (size_t i = 0; i < Size; ++i)
+                {
+                    if (keys.tags[i] < limit)
+                        continue;
+
+                    bool seen = false;
+                    for (size_t j = 0; j < i; ++j)
+                        seen = seen || keys.tags[j] == keys.tags[i];
+
+                    if (!seen)
+                        ++count;
+                }
+                return count;
+            }
+
+            constexpr unsigned hash(unsigned tag, uint32_t mult, unsigned bits)
+            {
+                return bits == 0 ? 0 : static_cast<unsigned>((static_cast<uint32_t>(tag) * mult) >> (32 - bits));
+            }
+
+            struct HashParams
+            {
+                uint32_t mult;
+                unsigned bits;
+            };
+
+            // Multiplicative hashing: look for a multiplier that does not produce
+            // any collision for the sparse tags, growing the table until we find one
+            template<size_t Size>
+            constexpr HashParams findHash(const Keys<Size>& keys, unsigned limit, size_t count)
+            {
+                unsigned bits = 0;
+                while ((size_t(1) << bits) < count * 2)
+                    ++bits;
+
+                for (; bits <= 16; ++bits)
+                {
+                    uint32_t mult = 0x9E3779B1u;
+                    for (unsigned attempt = 0; attempt < 256; ++attempt)
+                    {
+                        bool collision = false;
+                        for (size_t i = 0; i < Size && !collision; ++i)
+                        {
+                            if (keys.tags[i] < limit)
+                                continue;
+
+                            for (size_t j = 0; j < i && !collision; ++j)
+                            {
+                                if (keys.tags[j] < limit || keys.tags[j] == keys.tags[i])
+                                    continue;
+
+                                collision = hash(keys.tags[i], mult, bits) == hash(keys.tags[j], mult, bits);
+                            }
+                        }
+
+                        if (!collision)
+                            return HashParams { mult, bits };
+
+                        mult = (mult * 1664525u + 1013904223u) | 1u;
+                    }
+                }
+
+                return HashParams { 0, 0 };
+            }
+
+        } // namespace tag_table
+
+        template<int... Tags>
+        struct TagTable
+        {
+            static constexpr size_t Size = sizeof...(Tags);
+
+            static constexpr tag_table::Keys<Size> Keys = {{ static_cast<unsigned>(Tags)... }};
+
+            static constexpr size_t DenseSize = tag_table::maxBelow(Keys, tag_table::DenseLimit) + 1;
+            static constexpr size_t SparseCount = tag_table::countAbove(Keys, tag_table::DenseLimit);
+
+            static constexpr tag_table::HashParams Hash = tag_table::findHash(Keys, tag_table::DenseLimit, SparseCount);
+            static constexpr size_t SparseSize = size_t(1) << Hash.bits;
+
+            static_assert(SparseCount == 0 || Hash.mult != 0, "Could not find a perfect hash for the sparse tags");
+            static_assert(Size < UINT16_MAX, "Too many tags");
+
+            // Slots are 1-based, 0 meaning that the tag is not part of the table
+            struct Slots
+            {
+                uint16_t dense[DenseSize];
+                unsigned sparseKeys[SparseSize];
+                uint16_t sparse[SparseSize];
+            };
+
+            static constexpr Slots make()
+            {
+                Slots slots {};
+
+                // Iterate backward so that the first occurence of a tag wins
+                for (size_t i = Size; i > 0; --i)
+                {
+                    const auto tag = Keys.tags[i - 1];
+                    if (tag < DenseSize)
+                    {
+                        slots.dense[tag] = static_cast<uint16_t>(i);
+                    }
+                    else
+                    {
+                        const auto h = tag_table::hash(tag, Hash.mult, Hash.bits);
+                        slots.sparseKeys[h] = tag;
+                        slots.sparse[h] = static_cast<uint16_t>(i);
+                    }
+                }
+
+                return slots;
+            }
+
+            static constexpr Slots Value = make();
+
+            // Returns the index of the tag or -1 if the tag is not part of the table
+            static int of(unsigned tag)
+            {
+                if (tag < DenseSize)
+                    return static_cast<int>(Value.dense[tag]) - 1;
+
+                if (SparseCount == 0)
+                    return -1;
+
+                const auto h = tag_table::hash(tag, Hash.mult, Hash.bits);
+                if (Value.sparseKeys[h] != tag)
+                    return -1;
+
+                return static_cast<int>(Value.sparse[h]) - 1;
+            }
+        };
+
+        template<int... Tags>
+        constexpr tag_table::Keys<TagTable<Tags...>::Size> TagTable<Tags...>::Keys;
+
+        template<int... Tags>
+        constexpr tag_table::HashParams TagTable<Tags...>::Hash;
+
+        template<int... Tags>
+        constexpr typename TagTable<Tags...>::Slots TagTable<Tags...>::Value;
+
+    } // namespace details
+
+} // namespace Fixpp
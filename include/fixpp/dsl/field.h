@@ -78,6 +78,13 @@ namespace Fixpp
             return val_;
         }
 
+        template<typename Value>
+        bool tryGet(Value& value) const
+        {
+            value = val_;
+            return true;
+        }
+
         bool empty() const
         {
             return empty_;
@@ -121,9 +128,25 @@ namespace Fixpp
             m_view = view;
         }
 
-        Type get() const
+        // String and Data values are returned as std::string_view on the frame
+        typename details::RefCast<typename TagT::Type>::StorageType get() const
+        {
+            return details::RefCast<typename TagT::Type>::cast(m_view.first, m_view.second);
+        }
+
+        // Returns false, leaving value untouched, when the field is malformed. get() falls back
+        // to a default value instead, like the Epoch for the time types
+        template<typename Value>
+        bool tryGet(Value& value) const
         {
-            return details::LexicalCast<typename TagT::Type>::cast(m_view.first, m_view.second);
+            using Cast = details::RefCast<typename TagT::Type>;
+
+            typename Cast::StorageType result;
+            if (!Cast::tryCast(m_view.first, m_view.second, &result))
+                return false;
+
+            value = std::move(result);
+            return true;
         }
 
         View view() const
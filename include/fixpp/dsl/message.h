@@ -19,7 +19,7 @@
 #include <fixpp/dsl/details/unwrap.h>
 #include <fixpp/dsl/details/traits.h>
 #include <fixpp/dsl/details/flatten.h>
-#include <fixpp/utils/SmallVector.h>
+#include <fixpp/utils/arena.h>
 
 namespace Fixpp
 {
@@ -80,6 +80,9 @@ namespace Fixpp
 
         using Ref = MessageBase<FieldRef, Tags...>;
 
+        // Whether the message is made of FieldRefs to the frame it has been parsed from
+        static constexpr bool IsRef = std::is_same<MessageBase, Ref>::value;
+
         static constexpr size_t RequiredTags = meta::typelist::ops::Length<RequiredList>::value;
         // Note that TotalTags is *NOT* sizeof...(Tags) as we might have ComponentBlocks that
         // we flattened here. See flatten.h for more details
@@ -94,7 +97,6 @@ namespace Fixpp
         std::bitset<RequiredTags> requiredBits;
         std::bitset<TotalTags> allBits;
 
-        using View = std::pair<const char*, size_t>;
         struct Unparsed
         {
             Unparsed(int tag, const View& view)
@@ -106,7 +108,7 @@ namespace Fixpp
             View view;
         };
 
-        llvm::SmallVector<Unparsed, 10> unparsed;
+        ArenaVector<Unparsed, 10> unparsed;
     };
 
     // ------------------------------------------------
@@ -358,9 +360,21 @@ namespace Fixpp
         return meta::get<Index::Value>(message.values).view();
     }
 
-    template<typename Tag, typename Message>
+    namespace details
+    {
+        // The type of the value of a Tag, as read from a Message. Values of Ref messages
+        // are read from the frame, String and Data values being views on it
+        template<typename Tag, typename Message>
+        using ValueType = typename std::conditional<
+            Message::IsRef,
+            typename RefCast<typename Tag::Type>::UnderlyingType,
+            typename Tag::Type::UnderlyingType
+        >::type;
+    }
+
+    template<typename Tag, typename Message, typename Value>
     bool 
-    tryGet(const Message& message, typename Tag::Type::UnderlyingType& value)
+    tryGet(const Message& message, Value& value)
     {
         using Index = details::TagIndex<typename Message::TagsList, Tag>;
         static_assert(Index::Valid, "Invalid tag for given message");
@@ -368,12 +382,11 @@ namespace Fixpp
         if (!message.allBits.test(static_cast<size_t>(Index::Value)))
             return false;
 
-        value = meta::get<Index::Value>(message.values).get();
-        return true;
+        return meta::get<Index::Value>(message.values).tryGet(value);
     }
 
     template<typename Tag, typename Message>
-    std::optional< typename Tag::Type::UnderlyingType >
+    std::optional< details::ValueType<Tag, Message> >
     tryGet(const Message& message)
     {
         using Index = details::TagIndex<typename Message::TagsList, Tag>;
@@ -382,11 +395,15 @@ namespace Fixpp
         if (!message.allBits.test(static_cast<size_t>(Index::Value)))
             return {};
 
-        return meta::get<Index::Value>(message.values).get();
+        details::ValueType<Tag, Message> value;
+        if (!meta::get<Index::Value>(message.values).tryGet(value))
+            return {};
+
+        return value;
     }
 
     template<typename Tag, typename Message>
-    typename std::enable_if_t<IsTagDefinedV< Tag, Message >, std::optional< typename Tag::Type::UnderlyingType >>
+    typename std::enable_if_t<IsTagDefinedV< Tag, Message >, std::optional< details::ValueType<Tag, Message> >>
     tryUnsafeGet(const Message& message)
     {
         using Index = details::TagIndex<typename Message::TagsList, Tag>;
@@ -394,32 +411,35 @@ namespace Fixpp
         if (!message.allBits.test(static_cast<size_t>(Index::Value)))
             return {};
 
-        return meta::get<Index::Value>(message.values).get();
+        details::ValueType<Tag, Message> value;
+        if (!meta::get<Index::Value>(message.values).tryGet(value))
+            return {};
+
+        return value;
     }
 
-    template<typename Tag, typename Message>
+    template<typename Tag, typename Message, typename Value>
     typename std::enable_if_t<IsTagDefinedV< Tag, Message >, bool>
-    tryUnsafeGet(const Message& message, typename Tag::Type::UnderlyingType& value)
+    tryUnsafeGet(const Message& message, Value& value)
     {
         using Index = details::TagIndex<typename Message::TagsList, Tag>;
 
         if (!message.allBits.test(static_cast<size_t>(Index::Value)))
             return false;
 
-        value = meta::get<Index::Value>(message.values).get();
-        return true;
+        return meta::get<Index::Value>(message.values).tryGet(value);
     }
 
     template<typename Tag, typename Message>
-    typename std::enable_if_t<!IsTagDefinedV< Tag, Message >, std::optional< typename Tag::Type::UnderlyingType >>
+    typename std::enable_if_t<!IsTagDefinedV< Tag, Message >, std::optional< details::ValueType<Tag, Message> >>
     tryUnsafeGet(const Message&)
     {
         return {};
     }
 
-    template<typename Tag, typename Message>
+    template<typename Tag, typename Message, typename Value>
     typename std::enable_if_t<!IsTagDefinedV< Tag, Message >, bool>
-    tryUnsafeGet(const Message&, typename Tag::Type::UnderlyingType&)
+    tryUnsafeGet(const Message&, Value&)
     {
         return false;
     }
@@ -8,9 +8,11 @@
 
 #include <vector>
 #include <sstream>
+#include <stdexcept>
 
 #include <fixpp/dsl/field.h>
 #include <fixpp/utils/SmallVector.h>
+#include <fixpp/utils/arena.h>
 
 namespace Fixpp
 {
@@ -108,6 +110,82 @@ namespace Fixpp
         Type val_;
     };
 
+    // ------------------------------------------------
+    // GroupView
+    // ------------------------------------------------
+
+    // A read-only view on the instances of a parsed repeating group.
+    // Instances are never copied: the view only holds a pointer to the
+    // instances owned by the FieldRef, and is thus only valid as long
+    // as the message it comes from.
+
+    template<typename Instance>
+    class GroupView
+    {
+    public:
+        using value_type = Instance;
+        using const_reference = const Instance&;
+        using const_iterator = const Instance*;
+        using iterator = const_iterator;
+
+        GroupView()
+            : data_(nullptr)
+            , size_(0)
+        { }
+
+        GroupView(const Instance* data, size_t size)
+            : data_(data)
+            , size_(size)
+        { }
+
+        const Instance& operator[](size_t index) const
+        {
+            return data_[index];
+        }
+
+        const Instance& at(size_t index) const
+        {
+            if (index >= size_)
+                throw std::out_of_range("Bad instance access: index is out of range");
+
+            return data_[index];
+        }
+
+        const Instance& front() const
+        {
+            return data_[0];
+        }
+
+        const Instance& back() const
+        {
+            return data_[size_ - 1];
+        }
+
+        const_iterator begin() const
+        {
+            return data_;
+        }
+
+        const_iterator end() const
+        {
+            return data_ + size_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+    private:
+        const Instance* data_;
+        size_t size_;
+    };
+
     // ------------------------------------------------
     // FieldRef
     // ------------------------------------------------
@@ -128,7 +206,7 @@ namespace Fixpp
         using Tag = GroupTag;
 
 		using GroupType = InstanceGroupRef<SmallRepeatingGroup<GroupTag, SizeHint<Size>, Tags...>>;
-        using Values = llvm::SmallVector<GroupType, Size>;
+        using Values = ArenaVector<GroupType, Size>;
 
         FieldRef() = default;
 
@@ -154,9 +232,31 @@ namespace Fixpp
             values.reserve(size);
         }
 
-        Values get() const
+        // Removes every instance, keeping the storage around
+        void clear()
+        {
+            values.clear();
+        }
+
+        // Returns a view on the instances of the group, without copying them
+        GroupView<GroupType> get() const
         {
-            return values;
+            return GroupView<GroupType>(values.data(), values.size());
+        }
+
+        const GroupType& operator[](size_t index) const
+        {
+            return values[index];
+        }
+
+        typename Values::const_iterator begin() const
+        {
+            return values.begin();
+        }
+
+        typename Values::const_iterator end() const
+        {
+            return values.end();
         }
 
         size_t size() const
@@ -164,6 +264,11 @@ namespace Fixpp
             return values.size();
         }
 
+        bool empty() const
+        {
+            return values.empty();
+        }
+
     private:
         Values values;
     };
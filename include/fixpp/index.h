@@ -0,0 +1,219 @@
+/* index.h
+
+  A structural index of a FIX frame.
+
+  Building the index is the first stage of a two-stage parser: a SIMD pass
+  computes a bitmap of every '=' and SOH byte of the frame, which is then
+  walked to emit a compact array of (tag, value offset, value length)
+  entries, one per field. The second stage (see visitIndex() in visitor.h)
+  resolves the entries into the fields of a message.
+
+  The index can also be used on its own to look up a tag, route or log a
+  frame without rescanning it. An index keeps its storage between calls to
+  build(), which makes it cheap to reuse for every frame of a session.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <fixpp/view.h>
+#include <fixpp/utils/simd.h>
+#include <fixpp/utils/soh.h>
+#include <fixpp/utils/swar.h>
+
+namespace Fixpp
+{
+
+    struct FieldEntry
+    {
+        uint32_t tag;
+
+        // Offset of the value inside the frame
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    class FieldIndex
+    {
+    public:
+        using Entries = std::vector<FieldEntry>;
+        using const_iterator = Entries::const_iterator;
+
+        // Tags are at most 9 digits long
+        static constexpr size_t MaxTagDigits = 9;
+
+        FieldIndex()
+            : frame_(nullptr)
+            , frameSize_(0)
+            , errorOffset_(0)
+        { }
+
+        // Indexes every field of the frame. Returns false if the frame is malformed,
+        // in which case errorOffset() gives the offset at which the error occured.
+        // The frame must outlive the index
+        bool build(const char* frame, size_t size)
+        {
+            frame_ = frame;
+            frameSize_ = size;
+            errorOffset_ = 0;
+            entries_.clear();
+
+            bits_.resize((size + 63) / 64);
+            simd::bitmap(frame, frame + size, '=', SOH, bits_.data());
+
+            size_t fieldStart = 0;
+            size_t valueStart = 0;
+            uint32_t tag = 0;
+            bool inValue = false;
+
+            for (size_t word = 0; word < bits_.size(); ++word)
+            {
+                uint64_t bits = bits_[word];
+                while (bits != 0)
+                {
+                    const size_t pos = word * 64 + simd::details::countTrailingZeros64(bits);
+                    bits &= bits - 1;
+
+                    if (!inValue)
+                    {
+                        if (frame[pos] != '=' || !parseTag(fieldStart, pos, &tag))
+                            return fail(fieldStart);
+
+                        valueStart = pos + 1;
+                        inValue = true;
+                    }
+                    // A '=' inside a value is part of the value
+                    else if (frame[pos] == SOH)
+                    {
+                        add(tag, valueStart, pos);
+                        fieldStart = pos + 1;
+                        inValue = false;
+                    }
+                }
+            }
+
+            // The last field is allowed not to be terminated by a SOH
+            if (inValue)
+                add(tag, valueStart, size);
+            else if (fieldStart != size)
+                return fail(fieldStart);
+
+            return true;
+        }
+
+        void clear()
+        {
+            frame_ = nullptr;
+            frameSize_ = 0;
+            entries_.clear();
+        }
+
+        const char* frame() const
+        {
+            return frame_;
+        }
+
+        size_t frameSize() const
+        {
+            return frameSize_;
+        }
+
+        size_t errorOffset() const
+        {
+            return errorOffset_;
+        }
+
+        size_t size() const
+        {
+            return entries_.size();
+        }
+
+        bool empty() const
+        {
+            return entries_.empty();
+        }
+
+        const FieldEntry& operator[](size_t index) const
+        {
+            return entries_[index];
+        }
+
+        const_iterator begin() const
+        {
+            return entries_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return entries_.end();
+        }
+
+        View view(const FieldEntry& entry) const
+        {
+            return make_view(frame_ + entry.offset, entry.size);
+        }
+
+        View view(size_t index) const
+        {
+            return view(entries_[index]);
+        }
+
+        // Offset of the tag of a field inside the frame
+        size_t fieldOffset(size_t index) const
+        {
+            if (index == 0)
+                return 0;
+
+            const auto& previous = entries_[index - 1];
+            return previous.offset + previous.size + 1;
+        }
+
+        // Returns the first field with a given tag or nullptr
+        const FieldEntry* find(unsigned tag) const
+        {
+            for (const auto& entry: entries_)
+            {
+                if (entry.tag == tag)
+                    return &entry;
+            }
+
+            return nullptr;
+        }
+
+    private:
+        bool parseTag(size_t first, size_t last, uint32_t* tag) const
+        {
+            if (first == last || last - first > MaxTagDigits)
+                return false;
+
+            uint64_t value;
+            if (swar::parseUnsigned(frame_ + first, frame_ + last, UINT32_MAX, &value) != last - first)
+                return false;
+
+            *tag = static_cast<uint32_t>(value);
+            return true;
+        }
+
+        void add(uint32_t tag, size_t first, size_t last)
+        {
+            entries_.push_back(FieldEntry { tag, static_cast<uint32_t>(first), static_cast<uint32_t>(last - first) });
+        }
+
+        bool fail(size_t offset)
+        {
+            errorOffset_ = offset;
+            return false;
+        }
+
+        const char* frame_;
+        size_t frameSize_;
+        size_t errorOffset_;
+
+        Entries entries_;
+        std::vector<uint64_t> bits_;
+    };
+
+} // namespace Fixpp
@@ -0,0 +1,276 @@
+/* log.h
+
+  Parallel visit of FIX logs.
+
+  A log is a sequence of frames, usually one per line. The log is split in
+  chunks that start on a frame boundary (8=FIX) and chunks are handed out to
+  a pool of worker threads. Each worker visits the frames of its chunks with
+  its own visitor: frames are never copied and no memory is allocated per frame
+  by the log machinery itself.
+
+  When the original sequence of frames matters, visitLogOrdered() collects
+  the values returned by the visitors and hands them out in the order of the
+  log, as soon as every previous chunk has been visited. Frames that could not
+  be visited are handed out in the same order, along with their error.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fixpp/splitter.h>
+#include <fixpp/view.h>
+#include <fixpp/visitor.h>
+#include <fixpp/utils/simd.h>
+#include <fixpp/utils/soh.h>
+
+namespace Fixpp
+{
+
+    namespace impl
+    {
+
+        namespace log
+        {
+
+            // Chunks are smaller than the share of every worker, which balances the
+            // load between workers and bounds the latency of the ordered merge
+            static constexpr size_t ChunksPerWorker = 8;
+
+            // A frame starts with 8=FIX at the beginning of the log, of a line or right
+            // after the trailer of the previous frame
+            inline bool isFrameStart(const char* first, const char* cur, const char* last)
+            {
+                if (last - cur < 5 || std::memcmp(cur, "8=FIX", 5) != 0)
+                    return false;
+
+                return cur == first || cur[-1] == '\n' || cur[-1] == '\r' || cur[-1] == SOH;
+            }
+
+            inline const char* nextFrame(const char* first, const char* cur, const char* last)
+            {
+                while (cur != last)
+                {
+                    cur = simd::find(cur, last, '8');
+                    if (cur == last || isFrameStart(first, cur, last))
+                        break;
+
+                    ++cur;
+                }
+
+                return cur;
+            }
+
+            // Runs func(worker, chunk) for every chunk on a pool of workers
+            template<typename Func>
+            void run(size_t workers, size_t chunks, Func func)
+            {
+                std::atomic<size_t> next(0);
+
+                std::vector<std::thread> threads;
+                threads.reserve(workers);
+
+                for (size_t worker = 0; worker < workers; ++worker)
+                {
+                    threads.emplace_back([&, worker]() {
+                        size_t chunk;
+                        while ((chunk = next.fetch_add(1, std::memory_order_relaxed)) < chunks)
+                            func(worker, chunk);
+                    });
+                }
+
+                for (auto& thread: threads)
+                    thread.join();
+            }
+
+        } // namespace log
+
+    } // namespace impl
+
+    // ------------------------------------------------
+    // LogStats
+    // ------------------------------------------------
+
+    struct LogStats
+    {
+        LogStats()
+            : frames(0)
+            , errors(0)
+            , skipped(0)
+        { }
+
+        LogStats& operator+=(const LogStats& other)
+        {
+            frames += other.frames;
+            errors += other.errors;
+            skipped += other.skipped;
+            return *this;
+        }
+
+        // Number of frames that have been successfully visited
+        size_t frames;
+
+        // Number of frames that could not be visited
+        size_t errors;
+
+        // Number of bytes that did not belong to any frame
+        size_t skipped;
+    };
+
+    // Splits a log in at most count chunks, every chunk starting on a frame boundary
+
+    inline std::vector<View> splitLog(const char* data, size_t size, size_t count)
+    {
+        std::vector<View> chunks;
+        chunks.reserve(count);
+
+        const char* last = data + size;
+        const char* begin = data;
+
+        for (size_t i = 1; i <= count && begin != last; ++i)
+        {
+            const char* end = last;
+            if (i < count)
+            {
+                const char* target = std::max(begin + 1, data + (size / count) * i);
+                end = target < last ? impl::log::nextFrame(data, target, last) : last;
+            }
+
+            chunks.push_back(make_view(begin, static_cast<size_t>(end - begin)));
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    // Visits every frame of a log in parallel, running one worker per visitor.
+    // Every worker owns its visitor, which means that visitors do not need
+    // any synchronization. Visitors are left untouched once the log has been
+    // visited, making it possible to merge their state
+
+    template<typename Visitor, typename Rules>
+    LogStats visitLog(const char* data, size_t size, std::vector<Visitor>& visitors, Rules rules)
+    {
+        const size_t workers = visitors.size();
+        const auto chunks = splitLog(data, size, workers * impl::log::ChunksPerWorker);
+
+        std::vector<LogStats> stats(workers);
+
+        impl::log::run(workers, chunks.size(), [&](size_t worker, size_t chunk) {
+            auto& visitor = visitors[worker];
+            auto& workerStats = stats[worker];
+
+            FrameSplitter splitter;
+            splitter.feed(chunks[chunk].first, chunks[chunk].second, [&](const View& frame) {
+                if (visit(frame.first, frame.second, visitor, rules).isOk())
+                    ++workerStats.frames;
+                else
+                    ++workerStats.errors;
+            });
+
+            workerStats.skipped += splitter.skipped() + splitter.pending();
+        });
+
+        LogStats total;
+        for (const auto& workerStats: stats)
+            total += workerStats;
+
+        return total;
+    }
+
+    // Same as visitLog() but collects the values returned by the visitors and
+    // calls consumer with every value, in the order of the log. Every frame that
+    // could not be visited is handed to onError along with its error, in the order
+    // of the log as well. Both are called from the calling thread while the workers
+    // are still visiting the remaining of the log
+
+    template<typename Visitor, typename Rules, typename Consumer, typename ErrorConsumer>
+    LogStats visitLogOrdered(const char* data, size_t size, std::vector<Visitor>& visitors, Rules rules,
+                             Consumer consumer, ErrorConsumer onError)
+    {
+        using ResultType = typename Visitor::ResultType;
+        static_assert(!std::is_void<ResultType>::value, "An ordered visit requires a Visitor that returns a value");
+
+        using Entry = std::pair<View, VisitError<ResultType>>;
+
+        const size_t workers = visitors.size();
+        const auto chunks = splitLog(data, size, workers * impl::log::ChunksPerWorker);
+
+        std::vector<std::vector<Entry>> results(chunks.size());
+        std::vector<char> done(chunks.size(), 0);
+        std::vector<LogStats> stats(workers);
+
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        std::thread pool([&]() {
+            impl::log::run(workers, chunks.size(), [&](size_t worker, size_t chunk) {
+                auto& visitor = visitors[worker];
+                auto& workerStats = stats[worker];
+                auto& entries = results[chunk];
+
+                FrameSplitter splitter;
+                splitter.feed(chunks[chunk].first, chunks[chunk].second, [&](const View& frame) {
+                    auto result = visit(frame.first, frame.second, visitor, rules);
+                    if (result.isOk())
+                        ++workerStats.frames;
+                    else
+                        ++workerStats.errors;
+
+                    entries.emplace_back(frame, std::move(result));
+                });
+
+                workerStats.skipped += splitter.skipped() + splitter.pending();
+
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    done[chunk] = 1;
+                }
+                cv.notify_one();
+            });
+        });
+
+        for (size_t chunk = 0; chunk < chunks.size(); ++chunk)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() { return done[chunk] != 0; });
+            }
+
+            for (const auto& entry: results[chunk])
+            {
+                if (entry.second.isOk())
+                    consumer(entry.second.unwrap());
+                else
+                    onError(entry.first, entry.second.unwrapErr());
+            }
+
+            std::vector<Entry>().swap(results[chunk]);
+        }
+
+        pool.join();
+
+        LogStats total;
+        for (const auto& workerStats: stats)
+            total += workerStats;
+
+        return total;
+    }
+
+    // Frames that could not be visited are only accounted for in the LogStats
+
+    template<typename Visitor, typename Rules, typename Consumer>
+    LogStats visitLogOrdered(const char* data, size_t size, std::vector<Visitor>& visitors, Rules rules, Consumer consumer)
+    {
+        return visitLogOrdered(data, size, visitors, rules, consumer, [](const View&, const ErrorKind&) { });
+    }
+
+} // namespace Fixpp
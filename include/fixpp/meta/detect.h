@@ -39,4 +39,7 @@ namespace meta
 
     template <template<class...> class Op, class... Args>
     using detected_t = typename detail::detector<nonesuch, void, Op, Args...>::type;
+
+    template <class Default, template<class...> class Op, class... Args>
+    using detected_or_t = typename detail::detector<Default, void, Op, Args...>::type;
 }
@@ -0,0 +1,297 @@
+/* splitter.h
+
+  Splits a stream of bytes (as received from a TCP connection, for example)
+  into complete FIX frames that can be directly handed to visit().
+
+  Bytes are fed as chunks of arbitrary size: a chunk can contain many frames,
+  a partial frame or both. The end of a frame is located through its
+  BodyLength, without scanning its content. Frames that are entirely held by
+  a chunk are handed out as Views into the caller's buffer. Only frames that
+  straddle two or more chunks are copied into an internal buffer.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <fixpp/view.h>
+#include <fixpp/utils/simd.h>
+#include <fixpp/utils/soh.h>
+
+namespace Fixpp
+{
+
+    namespace impl
+    {
+
+        namespace splitter
+        {
+
+            // 8=FIXT.1.1<SOH>9=NNNNNN<SOH> fits in 32 bytes
+            static constexpr size_t MaxHeaderSize = 32;
+
+            // 10=NNN<SOH>
+            static constexpr size_t TrailerSize = 7;
+
+            enum class Status { Ok, Incomplete, Invalid };
+
+            // Parses the BeginString and BodyLength fields at the beginning of [first, last)
+            // and retrieves the total size of the frame
+            inline Status parseHeader(const char* first, const char* last, size_t maxFrameSize, size_t* size)
+            {
+                const size_t available = static_cast<size_t>(last - first);
+                const char* headerLast = available < MaxHeaderSize ? last : first + MaxHeaderSize;
+                const Status incomplete = available < MaxHeaderSize ? Status::Incomplete : Status::Invalid;
+
+                if (available < 2)
+                    return available == 0 || first[0] == '8' ? Status::Incomplete : Status::Invalid;
+
+                if (first[0] != '8' || first[1] != '=')
+                    return Status::Invalid;
+
+                const char* p = simd::find(first + 2, headerLast, SOH);
+                if (p == headerLast)
+                    return incomplete;
+
+                ++p;
+                if (headerLast - p < 2)
+                    return incomplete;
+
+                if (p[0] != '9' || p[1] != '=')
+                    return Status::Invalid;
+
+                p += 2;
+
+                size_t bodyLength = 0;
+                const char* digits = p;
+                while (p != headerLast && *p >= '0' && *p <= '9')
+                {
+                    bodyLength = bodyLength * 10 + static_cast<size_t>(*p - '0');
+                    if (bodyLength > maxFrameSize)
+                        return Status::Invalid;
+                    ++p;
+                }
+
+                if (p == headerLast)
+                    return incomplete;
+
+                if (p == digits || *p != SOH)
+                    return Status::Invalid;
+
+                *size = static_cast<size_t>(p + 1 - first) + bodyLength + TrailerSize;
+                return *size > maxFrameSize ? Status::Invalid : Status::Ok;
+            }
+
+            // Makes sure that a frame of a given size ends with a CheckSum field
+            inline bool hasTrailer(const char* frame, size_t size)
+            {
+                const char* trailer = frame + size - TrailerSize;
+                return trailer[-1] == SOH
+                    && trailer[0] == '1' && trailer[1] == '0' && trailer[2] == '='
+                    && trailer[TrailerSize - 1] == SOH;
+            }
+
+        } // namespace splitter
+
+    } // namespace impl
+
+    // ------------------------------------------------
+    // FrameSplitter
+    // ------------------------------------------------
+
+    // Views handed out by the FrameSplitter either point to the buffer passed to feed()
+    // or to the internal buffer of the splitter, in which case they are only valid
+    // during the call to the callback. Bytes that do not belong to a frame, like
+    // new lines between frames or the remaining of a corrupted frame, are skipped
+    // until the next BeginString.
+
+    class FrameSplitter
+    {
+    public:
+        static constexpr size_t DefaultMaxFrameSize = 64 * 1024;
+
+        explicit FrameSplitter(size_t maxFrameSize = DefaultMaxFrameSize)
+            : maxFrameSize_(maxFrameSize)
+            , expected_(0)
+            , skipped_(0)
+        { }
+
+        // Feeds a new chunk of the stream and calls func with a View on every
+        // complete frame. Returns the number of frames that have been handed out
+        template<typename Func>
+        size_t feed(const char* data, size_t size, Func func)
+        {
+            using namespace impl::splitter;
+
+            const char* first = data;
+            const char* last = data + size;
+
+            size_t frames = 0;
+
+            while (!pending_.empty())
+            {
+                first = completePending(first, last);
+                if (first == nullptr)
+                    return frames;
+
+                if (pending_.empty())
+                    break;
+
+                if (hasTrailer(pending_.data(), pending_.size()))
+                {
+                    func(make_view(pending_.data(), pending_.size()));
+                    ++frames;
+
+                    pending_.clear();
+                    expected_ = 0;
+                    break;
+                }
+
+                // A corrupted frame that straddles chunks is resynced right after its
+                // first byte, like any other corrupted frame: the bytes that have been
+                // buffered are scanned again and might leave a new pending frame
+                std::vector<char> buffered;
+                buffered.swap(pending_);
+                expected_ = 0;
+
+                ++skipped_;
+                frames += feed(buffered.data() + 1, buffered.size() - 1, func);
+            }
+
+            while (first != last)
+            {
+                size_t frameSize = 0;
+                const auto status = parseHeader(first, last, maxFrameSize_, &frameSize);
+
+                if (status == Status::Ok && frameSize <= static_cast<size_t>(last - first))
+                {
+                    if (hasTrailer(first, frameSize))
+                    {
+                        func(make_view(first, frameSize));
+                        ++frames;
+                        first += frameSize;
+                        continue;
+                    }
+                }
+                else if (status != Status::Invalid)
+                {
+                    // The frame straddles the end of the chunk
+                    expected_ = status == Status::Ok ? frameSize : 0;
+                    pending_.assign(first, last);
+                    break;
+                }
+
+                first = resync(first + 1, last);
+            }
+
+            return frames;
+        }
+
+        // Number of bytes that are waiting for the rest of their frame
+        size_t pending() const
+        {
+            return pending_.size();
+        }
+
+        // Number of bytes that have been skipped because they did not belong to a frame
+        size_t skipped() const
+        {
+            return skipped_;
+        }
+
+        void reset()
+        {
+            pending_.clear();
+            expected_ = 0;
+            skipped_ = 0;
+        }
+
+    private:
+
+        // Appends the beginning of the chunk to the pending frame. Returns the
+        // position in the chunk right after the pending frame, or nullptr if
+        // the pending frame is still not complete at the end of the chunk.
+        // The pending frame is left empty if it turned out to be corrupted
+        const char* completePending(const char* first, const char* last)
+        {
+            using namespace impl::splitter;
+
+            while (expected_ == 0)
+            {
+                const size_t missing = MaxHeaderSize - std::min(pending_.size(), MaxHeaderSize);
+                const size_t count = std::min(missing, static_cast<size_t>(last - first));
+                pending_.insert(pending_.end(), first, first + count);
+                first += count;
+
+                size_t frameSize = 0;
+                const auto status = parseHeader(pending_.data(), pending_.data() + pending_.size(), maxFrameSize_, &frameSize);
+
+                // Drop the pending bytes up to the next BeginString candidate
+                if (status == Status::Invalid)
+                {
+                    auto it = std::find(pending_.begin() + 1, pending_.end(), '8');
+                    skipped_ += static_cast<size_t>(it - pending_.begin());
+                    pending_.erase(pending_.begin(), it);
+
+                    if (pending_.empty())
+                        return first;
+                    continue;
+                }
+
+                if (status == Status::Incomplete)
+                {
+                    if (first == last)
+                        return nullptr;
+                    continue;
+                }
+
+                // We might have copied past the end of the frame
+                if (frameSize < pending_.size())
+                {
+                    first -= pending_.size() - frameSize;
+                    pending_.resize(frameSize);
+                }
+
+                expected_ = frameSize;
+            }
+
+            const size_t count = std::min(expected_ - pending_.size(), static_cast<size_t>(last - first));
+            pending_.insert(pending_.end(), first, first + count);
+            first += count;
+
+            if (pending_.size() < expected_)
+                return nullptr;
+
+            return first;
+        }
+
+        // Skips to the next BeginString
+        const char* resync(const char* first, const char* last)
+        {
+            const char* start = first - 1;
+
+            while (first != last)
+            {
+                first = simd::find(first, last, '8');
+                if (first == last || last - first < 2 || first[1] == '=')
+                    break;
+
+                ++first;
+            }
+
+            skipped_ += static_cast<size_t>(first - start);
+            return first;
+        }
+
+        size_t maxFrameSize_;
+
+        std::vector<char> pending_;
+        size_t expected_;
+
+        size_t skipped_;
+    };
+
+} // namespace Fixpp
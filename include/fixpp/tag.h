@@ -6,10 +6,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <limits>
 #include <optional>
+#include <stdexcept>
 #include <string>
 
 namespace Fixpp
@@ -122,39 +127,155 @@ namespace Fixpp
         using DayOfMonth = Int;
         using MonthYear = String;
 
+        // A UTCTimestamp is stored as a number of nanoseconds since the Epoch, along with its
+        // precision: the number of fractional digits (0, 3, 6 or 9) it has been parsed with,
+        // or requested with through the msec and usec parts or the duration of a time_point.
+        // It is written with at least that precision, and more digits when needed to represent
+        // it exactly: truncate it beforehand, through std::chrono::floor for example, to write
+        // it with a lower precision. Nanoseconds since the Epoch cover the years 1678 to 2261,
+        // timestamps outside of that range are rejected
+
         struct UTCTimestamp
         {
             struct Time
             {
+                using Clock = std::chrono::system_clock;
+                using Duration = std::chrono::nanoseconds;
+                using TimePoint = std::chrono::time_point<Clock, Duration>;
+
+                static constexpr int64_t NanosPerSecond = 1000000000;
+
+                // Seconds since the Epoch whose nanoseconds, sub-second part included, fit in an int64_t
+                static constexpr int64_t MinSeconds = std::numeric_limits<int64_t>::min() / NanosPerSecond;
+                static constexpr int64_t MaxSeconds = std::numeric_limits<int64_t>::max() / NanosPerSecond - 1;
+
                 Time()
-                    : m_time(std::time(nullptr))
+                    : Time(std::time(nullptr))
                 { }
 
+                // Throws std::out_of_range past the covered range
                 Time(std::time_t time, std::optional<int> msec = {}, std::optional<int> usec = {})
-                    : m_time(time)
-                    , m_msec(msec)
-                    , m_usec(usec)
+                    : m_nanos(secondsToNanoseconds(static_cast<int64_t>(time))
+                              + static_cast<int64_t>(msec.value_or(0)) * 1000000
+                              + static_cast<int64_t>(usec.value_or(0)) * 1000)
+                    , m_precision(usec ? 6 : msec ? 3 : 0)
                 { }
 
+                template<typename OtherDuration>
+                Time(std::chrono::time_point<Clock, OtherDuration> timePoint)
+                    : m_nanos(toNanoseconds(timePoint.time_since_epoch()))
+                    , m_precision(precisionOf(typename OtherDuration::period()))
+                { }
+
+                static bool inRange(int64_t secs)
+                {
+                    return secs >= MinSeconds && secs <= MaxSeconds;
+                }
+
+                // precision is one of 0, 3, 6 or 9
+                static Time fromNanoseconds(int64_t nanos, unsigned precision = 0)
+                {
+                    Time time(0);
+                    time.m_nanos = nanos;
+                    time.m_precision = static_cast<uint8_t>(precision);
+                    return time;
+                }
+
                 std::time_t time() const
                 {
-                    return m_time;
+                    return static_cast<std::time_t>(floorSeconds());
+                }
+
+                // Nanoseconds elapsed since the last second, in [0, 999999999]
+                int subsecond() const
+                {
+                    return static_cast<int>(m_nanos - floorSeconds() * NanosPerSecond);
                 }
 
                 std::optional<int> msec() const
                 {
-                    return m_msec;
+                    if (precision() < 3)
+                        return {};
+                    return subsecond() / 1000000;
                 }
 
                 std::optional<int> usec() const
                 {
-                    return m_usec;
+                    if (precision() < 6)
+                        return {};
+                    return subsecond() / 1000 % 1000;
+                }
+
+                std::optional<int> nsec() const
+                {
+                    if (precision() < 9)
+                        return {};
+                    return subsecond() % 1000;
+                }
+
+                // Number of fractional digits the timestamp is written with: its own precision,
+                // raised to the number of digits needed to represent it exactly
+                unsigned precision() const
+                {
+                    const int sub = subsecond();
+
+                    unsigned exact = 9;
+                    if (sub == 0)
+                        exact = 0;
+                    else if (sub % 1000000 == 0)
+                        exact = 3;
+                    else if (sub % 1000 == 0)
+                        exact = 6;
+
+                    return std::max<unsigned>(m_precision, exact);
+                }
+
+                int64_t nanoseconds() const
+                {
+                    return m_nanos;
+                }
+
+                TimePoint timePoint() const
+                {
+                    return TimePoint(Duration(m_nanos));
+                }
+
+                operator TimePoint() const
+                {
+                    return timePoint();
                 }
 
             private:
-                std::time_t m_time;
-                std::optional<int> m_msec;
-                std::optional<int> m_usec;
+                static int64_t secondsToNanoseconds(int64_t secs)
+                {
+                    if (!inRange(secs))
+                        throw std::out_of_range("UTCTimestamp out of range");
+
+                    return secs * NanosPerSecond;
+                }
+
+                // Whole seconds are range-checked before the duration is converted
+                template<typename Rep, typename Period>
+                static int64_t toNanoseconds(std::chrono::duration<Rep, Period> duration)
+                {
+                    const auto secs = std::chrono::floor<std::chrono::seconds>(duration);
+                    return secondsToNanoseconds(secs.count()) + std::chrono::duration_cast<Duration>(duration - secs).count();
+                }
+
+                template<intmax_t Num, intmax_t Den>
+                static constexpr uint8_t precisionOf(std::ratio<Num, Den>)
+                {
+                    return Den == 1 ? 0 : Den <= 1000 ? 3 : Den <= 1000000 ? 6 : 9;
+                }
+
+                int64_t floorSeconds() const
+                {
+                    const int64_t secs = m_nanos / NanosPerSecond;
+                    return m_nanos % NanosPerSecond < 0 ? secs - 1 : secs;
+                }
+
+                int64_t m_nanos;
+                uint8_t m_precision;
             };
 
             using StorageType = Time;
@@ -234,19 +355,18 @@ namespace Fixpp
 
         inline std::ostream& operator<<(std::ostream& os, const UTCTimestamp::Time& value)
         {
+            static constexpr int Divisors[] = { 1000000, 1000, 1 };
+
             auto time = value.time();
             char buffer[32];
             strftime(buffer, sizeof buffer, "%Y%m%d-%H:%M:%S", std::gmtime(&time));
             os << buffer;
-            if (value.msec())
+
+            const unsigned precision = value.precision();
+            if (precision > 0)
             {
-                sprintf(buffer, ".%03d", value.msec().value());
+                sprintf(buffer, ".%0*d", static_cast<int>(precision), value.subsecond() / Divisors[precision / 3 - 1]);
                 os << buffer;
-                if (value.usec())
-                {
-                    sprintf(buffer, "%03d", value.usec().value());
-                    os << buffer;
-                }
             }
             return os;
         }
@@ -0,0 +1,363 @@
+/* arena.h
+
+  Per-frame arena allocation.
+
+  Parsing a frame with large repeating groups or many custom tags spills the
+  inline storage of the Ref containers onto the heap. An Arena is a bump
+  allocator over a buffer supplied by the caller: while a frame is visited
+  with an Arena, every container of the Header and the Message that outgrows
+  its inline storage draws its memory from the Arena, and the Arena is reset
+  before the next frame. Once the buffer is exhausted, the Arena falls back
+  to an upstream memory_resource, the heap by default.
+
+  ArenaVector is the container used by the Refs: a vector with inline storage
+  for N elements, that allocates from the Arena of the frame being parsed, if
+  any. The Arena is set aside while the visitor is called: containers grown
+  by the visitor itself allocate from the heap, as they might outlive the frame.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Fixpp
+{
+
+    namespace details
+    {
+
+        namespace arena
+        {
+
+            // The memory_resource of the frame being parsed by the calling thread,
+            // nullptr when the frame is not parsed with an Arena
+            inline std::pmr::memory_resource*& current()
+            {
+                static thread_local std::pmr::memory_resource* resource = nullptr;
+                return resource;
+            }
+
+            struct Scope
+            {
+                explicit Scope(std::pmr::memory_resource* resource)
+                    : previous(current())
+                {
+                    current() = resource;
+                }
+
+                ~Scope()
+                {
+                    current() = previous;
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                std::pmr::memory_resource* previous;
+            };
+
+        } // namespace arena
+
+    } // namespace details
+
+    // ------------------------------------------------
+    // Arena
+    // ------------------------------------------------
+
+    // Pass std::pmr::null_memory_resource() as the upstream resource to make
+    // the visit throw std::bad_alloc instead of falling back to the heap when
+    // the buffer is exhausted
+
+    class Arena
+    {
+    public:
+        explicit Arena(size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : storage_(new unsigned char[capacity])
+            , resource_(storage_.get(), capacity, upstream)
+        { }
+
+        Arena(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : resource_(buffer, size, upstream)
+        { }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // Releases every allocation made since the last reset. Memory obtained
+        // from the upstream resource is given back to it
+        void reset()
+        {
+            resource_.release();
+        }
+
+        std::pmr::memory_resource* resource()
+        {
+            return &resource_;
+        }
+
+    private:
+        std::unique_ptr<unsigned char[]> storage_;
+        std::pmr::monotonic_buffer_resource resource_;
+    };
+
+    // ------------------------------------------------
+    // ArenaVector
+    // ------------------------------------------------
+
+    // Storage obtained from an Arena is never given back: it is released as a whole
+    // when the Arena is reset. Which is why clear() only keeps heap storage around
+    // and why copies always live on the heap, as they might outlive the Arena.
+
+    template<typename T, size_t N>
+    class ArenaVector
+    {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        ArenaVector()
+            : data_(inlineData())
+            , size_(0)
+            , capacity_(N)
+            , resource_(nullptr)
+        { }
+
+        ArenaVector(const ArenaVector& other)
+            : ArenaVector()
+        {
+            if (other.size_ > N)
+                grow(other.size_, std::pmr::new_delete_resource());
+
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+
+        ArenaVector(ArenaVector&& other)
+            : ArenaVector()
+        {
+            steal(other);
+        }
+
+        ArenaVector& operator=(const ArenaVector& other)
+        {
+            if (this != &other)
+            {
+                ArenaVector copy(other);
+                release();
+                steal(copy);
+            }
+
+            return *this;
+        }
+
+        ArenaVector& operator=(ArenaVector&& other)
+        {
+            if (this != &other)
+            {
+                release();
+                steal(other);
+            }
+
+            return *this;
+        }
+
+        ~ArenaVector()
+        {
+            release();
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ == capacity_)
+                return growAndEmplace(std::forward<Args>(args)...);
+
+            T* value = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *value;
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > capacity_)
+                grow(capacity, allocator());
+        }
+
+        // Destroys every element. Heap storage is kept around for the next elements,
+        // storage from an Arena is dropped as the Arena might be reset in-between
+        void clear()
+        {
+            if (resource_ != nullptr && resource_ != std::pmr::new_delete_resource())
+            {
+                release();
+            }
+            else
+            {
+                destroy(data_, data_ + size_);
+                size_ = 0;
+            }
+        }
+
+        T& operator[](size_t index) { return data_[index]; }
+        const T& operator[](size_t index) const { return data_[index]; }
+
+        T& front() { return data_[0]; }
+        const T& front() const { return data_[0]; }
+
+        T& back() { return data_[size_ - 1]; }
+        const T& back() const { return data_[size_ - 1]; }
+
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        // Whether the elements are held by the inline storage
+        bool isSmall() const { return data_ == inlineData(); }
+
+    private:
+        static std::pmr::memory_resource* allocator()
+        {
+            auto* resource = details::arena::current();
+            return resource != nullptr ? resource : std::pmr::new_delete_resource();
+        }
+
+        static void destroy(T* first, T* last)
+        {
+            if (!std::is_trivially_destructible<T>::value)
+            {
+                for (; first != last; ++first)
+                    first->~T();
+            }
+        }
+
+        T* inlineData()
+        {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        const T* inlineData() const
+        {
+            return reinterpret_cast<const T*>(inline_);
+        }
+
+        T* allocate(size_t capacity, std::pmr::memory_resource* resource)
+        {
+            return static_cast<T*>(resource->allocate(capacity * sizeof(T), alignof(T)));
+        }
+
+        // Moves the elements to new storage, the old storage is released
+        void adopt(T* data, size_t capacity, std::pmr::memory_resource* resource)
+        {
+            std::uninitialized_move(data_, data_ + size_, data);
+
+            const size_t size = size_;
+            release();
+
+            data_ = data;
+            size_ = size;
+            capacity_ = capacity;
+            resource_ = resource;
+        }
+
+        void grow(size_t minCapacity, std::pmr::memory_resource* resource)
+        {
+            const size_t capacity = std::max(capacity_ * 2, minCapacity);
+            adopt(allocate(capacity, resource), capacity, resource);
+        }
+
+        // The new element is constructed before moving the existing ones as it
+        // might be constructed from one of them
+        template<typename... Args>
+        T& growAndEmplace(Args&&... args)
+        {
+            auto* resource = allocator();
+            const size_t capacity = std::max<size_t>(capacity_ * 2, 1);
+
+            T* data = allocate(capacity, resource);
+            ::new (static_cast<void*>(data + size_)) T(std::forward<Args>(args)...);
+
+            adopt(data, capacity, resource);
+            ++size_;
+
+            return data_[size_ - 1];
+        }
+
+        // Destroys the elements, gives heap storage back and switches back
+        // to the inline storage
+        void release()
+        {
+            destroy(data_, data_ + size_);
+
+            if (resource_ == std::pmr::new_delete_resource())
+                resource_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+
+            data_ = inlineData();
+            size_ = 0;
+            capacity_ = N;
+            resource_ = nullptr;
+        }
+
+        void steal(ArenaVector& other)
+        {
+            if (other.isSmall())
+            {
+                std::uninitialized_move(other.begin(), other.end(), data_);
+                size_ = other.size_;
+                other.destroy(other.data_, other.data_ + other.size_);
+                other.size_ = 0;
+            }
+            else
+            {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                resource_ = other.resource_;
+
+                // The storage now belongs to us
+                other.resource_ = nullptr;
+                other.size_ = 0;
+                other.release();
+            }
+        }
+
+        T* data_;
+        size_t size_;
+        size_t capacity_;
+
+        // The resource the storage comes from, nullptr for the inline storage
+        std::pmr::memory_resource* resource_;
+
+        alignas(T) unsigned char inline_[(N ? N : 1) * sizeof(T)];
+    };
+
+} // namespace Fixpp
@@ -8,7 +8,13 @@
 #include <cstddef>
 #include <cctype>
 #include <cstring>
+#include <limits>
+#include <string>
 #include <streambuf>
+#include <utility>
+
+#include <fixpp/utils/simd.h>
+#include <fixpp/utils/swar.h>
 
 template<typename CharT = char>
 class StreamBuf : public std::basic_streambuf<CharT> {
@@ -36,6 +42,10 @@ public:
         return this->gptr() - this->eback();
     }
 
+    void bump(size_t count) {
+        this->gbump(static_cast<int>(count));
+    }
+
     void reset() {
         this->setg(nullptr, nullptr, nullptr);
     }
@@ -151,10 +161,7 @@ public:
         if (count > static_cast< size_t >(buf->in_avail()))
             return false;
 
-        for (size_t i = 0; i < count; ++i) {
-            buf->sbumpc();
-        }
-
+        buf->bump(count);
         return true;
     }
 
@@ -213,11 +220,164 @@ public:
 };
 
 
+// A lightweight cursor over a contiguous read-only buffer, made of a
+// begin / current / end pointer triple. Unlike the StreamCursor, it does
+// not go through the std::basic_streambuf machinery and advances in O(1)
+
+class RawCursor {
+public:
+    RawCursor(const char* begin, const char* end)
+        : begin_(begin)
+        , cur_(begin)
+        , end_(end)
+    { }
+
+    RawCursor(const char* begin, size_t len)
+        : begin_(begin)
+        , cur_(begin)
+        , end_(begin + len)
+    { }
+
+    static constexpr int Eof = -1;
+
+    struct Token {
+        Token(RawCursor& cursor)
+            : cursor(cursor)
+            , ptr(cursor.cur_)
+        { }
+
+        size_t start() const { return static_cast<size_t>(ptr - cursor.begin_); }
+
+        size_t end() const {
+            return static_cast<size_t>(cursor);
+        }
+
+        size_t size() const {
+            return static_cast<size_t>(cursor.cur_ - ptr);
+        }
+
+        std::string text() {
+            return std::string(ptr, size());
+        }
+
+        const char* rawText() const {
+            return ptr;
+        }
+
+        std::pair<const char*, size_t> view() const
+        {
+            return std::make_pair(ptr, size());
+        }
+
+    private:
+        RawCursor& cursor;
+        const char* ptr;
+    };
+
+    struct Revert {
+        Revert(RawCursor& cursor)
+            : cursor(cursor)
+            , ptr(cursor.cur_)
+            , active(true)
+        { }
+
+        ~Revert() {
+            if (active)
+                revert();
+        }
+
+        void revert() {
+            cursor.cur_ = ptr;
+        }
+
+        void ignore() {
+            active = false;
+        }
+
+    private:
+        RawCursor& cursor;
+        const char* ptr;
+        bool active;
+    };
+
+    bool advance(size_t count)
+    {
+        if (count > remaining())
+            return false;
+
+        cur_ += count;
+        return true;
+    }
+
+    operator size_t() const { return static_cast<size_t>(cur_ - begin_); }
+
+    bool eof() const
+    {
+        return cur_ == end_;
+    }
+
+    int next() const
+    {
+        if (remaining() < 2)
+            return Eof;
+
+        return cur_[1];
+    }
+
+    char current() const
+    {
+        return eof() ? static_cast< char >(Eof) : *cur_;
+    }
+
+    const char* offset() const
+    {
+        return cur_;
+    }
+
+    const char* offset(size_t off) const
+    {
+        return begin_ + off;
+    }
+
+    size_t diff(size_t other) const
+    {
+        return static_cast<size_t>(*this) - other;
+    }
+
+    size_t diff(const RawCursor& other) const
+    {
+        return static_cast<size_t>(other) - static_cast<size_t>(*this);
+    }
+
+    size_t remaining() const
+    {
+        return static_cast<size_t>(end_ - cur_);
+    }
+
+    void reset()
+    {
+        begin_ = cur_ = end_ = nullptr;
+    }
+
+    void reset(const char* begin, size_t len)
+    {
+        begin_ = cur_ = begin;
+        end_ = begin + len;
+    }
+
+private:
+    const char* begin_;
+    const char* cur_;
+    const char* end_;
+};
+
+
 enum class CaseSensitivity {
     Sensitive, Insensitive
 };
 
-inline bool match_raw(const void* buf, size_t len, StreamCursor& cursor)
+template<typename Cursor>
+bool match_raw(const void* buf, size_t len, Cursor& cursor)
 {
     if (cursor.remaining() < len)
         return false;
@@ -230,7 +390,8 @@ inline bool match_raw(const void* buf, size_t len, StreamCursor& cursor)
     return false;
 }
 
-inline bool match_string(const char *str, size_t len, StreamCursor& cursor,
+template<typename Cursor>
+bool match_string(const char *str, size_t len, Cursor& cursor,
         CaseSensitivity cs = CaseSensitivity::Insensitive)
 {
     if (cursor.remaining() < len)
@@ -256,7 +417,8 @@ inline bool match_string(const char *str, size_t len, StreamCursor& cursor,
     return false;
 }
 
-inline bool match_literal(char c, StreamCursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
+template<typename Cursor>
+bool match_literal(char c, Cursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
 {
     if (cursor.eof())
         return false;
@@ -272,7 +434,8 @@ inline bool match_literal(char c, StreamCursor& cursor, CaseSensitivity cs = Cas
     return false;
 }
 
-inline bool match_literal_fast(char c, StreamCursor& cursor)
+template<typename Cursor>
+bool match_literal_fast(char c, Cursor& cursor)
 {
     if (cursor.eof())
         return false;
@@ -285,23 +448,26 @@ inline bool match_literal_fast(char c, StreamCursor& cursor)
     return false;
 }
 
-inline bool match_until(char c, StreamCursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
+template<typename Cursor>
+bool match_until(char c, Cursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
 {
     return match_until( { c }, cursor, cs);
 }
 
-inline bool match_until_fast(char c, StreamCursor& cursor)
+template<typename Cursor>
+bool match_until_fast(char c, Cursor& cursor)
 {
-    while (!cursor.eof()) {
-        const char cur = cursor.current();
-        if (c == cur) return true;
-        cursor.advance(1);
-    }
+    const char* first = cursor.offset();
+    const char* last = first + cursor.remaining();
 
-    return false;
+    const char* pos = Fixpp::simd::find(first, last, c);
+    cursor.advance(static_cast<size_t>(pos - first));
+
+    return pos != last;
 }
 
-inline bool match_until(std::initializer_list<char> chars, StreamCursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
+template<typename Cursor>
+bool match_until(std::initializer_list<char> chars, Cursor& cursor, CaseSensitivity cs = CaseSensitivity::Insensitive)
 {
     if (cursor.eof())
         return false;
@@ -326,7 +492,8 @@ inline bool match_until(std::initializer_list<char> chars, StreamCursor& cursor,
     return false;
 }
 
-inline bool match_double(double* val, StreamCursor& cursor)
+template<typename Cursor>
+bool match_double(double* val, Cursor& cursor)
 {
     // @Todo: strtod does not support a length argument
     char *end;
@@ -338,7 +505,8 @@ inline bool match_double(double* val, StreamCursor& cursor)
     return true;
 }
 
-inline bool match_int(int* val, StreamCursor& cursor)
+template<typename Cursor>
+bool match_int(int* val, Cursor& cursor)
 {
     char *end;
     *val = strtol(cursor.offset(), &end, 10);
@@ -349,53 +517,40 @@ inline bool match_int(int* val, StreamCursor& cursor)
     return true;
 }
 
-inline bool match_int_fast_n(int *val, StreamCursor& cursor, size_t size)
+// Parses an int of at most size digits, or of any number of digits when size is 0.
+// Values that do not fit in an int are rejected
+template<typename Cursor>
+bool match_int_fast_n(int *val, Cursor& cursor, size_t size)
 {
-    if (cursor.eof())
-        return false;
+    const size_t remaining = cursor.remaining();
+    const size_t limit = size > 0 && size < remaining ? size : remaining;
 
-    size_t i = 0;
     const char* p = cursor.offset();
-    size_t remaining = cursor.remaining();
-
-    int integer = 0;
 
-    for (;;)
-    {
-        const char c = *p++;
-        if (!(c >= '0' && c <= '9'))
-            break;
-
-        integer *= 10;
-        integer += (c - '0');
-
-        ++i;
-        if (--remaining == 0 || (size > 0 && i == size))
-            break;
-    }
-
-    if (i > 0) {
-        *val = integer;
-        cursor.advance(i);
-        return true;
-    }
-
-    return false;
+    uint64_t integer;
+    const size_t count = Fixpp::swar::parseUnsigned(p, p + limit, std::numeric_limits<int>::max(), &integer);
+    if (count == 0)
+        return false;
 
+    *val = static_cast<int>(integer);
+    cursor.advance(count);
+    return true;
 }
 
-inline bool match_int_fast(int* val, StreamCursor& cursor)
+template<typename Cursor>
+bool match_int_fast(int* val, Cursor& cursor)
 {
     return match_int_fast_n(val, cursor, 0);
 }
 
-inline void skip_whitespaces(StreamCursor& cursor)
+template<typename Cursor>
+void skip_whitespaces(Cursor& cursor)
 {
     if (cursor.eof())
         return;
 
     int c;
-    while ((c = cursor.current()) != StreamCursor::Eof && (c == ' ' || c == '\t')) {
+    while ((c = cursor.current()) != Cursor::Eof && (c == ' ' || c == '\t')) {
         cursor.advance(1);
     }
 }
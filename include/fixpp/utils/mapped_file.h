@@ -0,0 +1,117 @@
+/* mapped_file.h
+
+  A read-only view on the content of a file, memory mapped when the
+  platform supports it and read in memory otherwise.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #define FIXPP_HAS_MMAP
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+  #include <iterator>
+  #include <vector>
+#endif
+
+namespace Fixpp
+{
+
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string& path)
+            : data_(nullptr)
+            , size_(0)
+        {
+            map(path);
+        }
+
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        ~MappedFile()
+        {
+            unmap();
+        }
+
+        const char* data() const
+        {
+            return data_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+#if defined(FIXPP_HAS_MMAP)
+        void map(const std::string& path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+                throw std::runtime_error("Could not open '" + path + "'");
+
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                throw std::runtime_error("Could not stat '" + path + "'");
+            }
+
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ > 0)
+            {
+                void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("Could not map '" + path + "'");
+                }
+
+                // The file is read front to back by every worker
+                ::madvise(addr, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char *>(addr);
+            }
+
+            ::close(fd);
+        }
+
+        void unmap()
+        {
+            if (data_ != nullptr)
+                ::munmap(const_cast<char *>(data_), size_);
+        }
+#else
+        void map(const std::string& path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                throw std::runtime_error("Could not open '" + path + "'");
+
+            buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+
+        void unmap()
+        {
+        }
+
+        std::vector<char> buffer_;
+#endif
+
+        const char* data_;
+        size_t size_;
+    };
+
+} // namespace Fixpp
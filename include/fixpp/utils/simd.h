@@ -0,0 +1,309 @@
+/* simd.h
+
+  SIMD kernels used to scan a FIX frame.
+
+  Searching for the next delimiter (SOH or '=') is the most common operation
+  of the parser, as every single value has to be scanned up to its SOH. The
+  kernels below compare 16 (SSE2) or 32 (AVX2) bytes at a time, the best
+  available kernel being selected at run-time through CPU feature detection.
+  A scalar kernel is used on other architectures.
+
+  The same goes for the byte sum used to validate the CheckSum of a frame,
+  which is computed with psadbw 16 or 32 bytes at a time, and for the
+  structural bitmap of a frame (one bit per '=' or SOH byte) used by the
+  FieldIndex.
+
+  Defining FIXPP_NO_SIMD disables all SIMD kernels.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(FIXPP_NO_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FIXPP_SIMD_SSE2
+    #include <emmintrin.h>
+  #endif
+
+  #if defined(FIXPP_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+    #define FIXPP_SIMD_AVX2
+    #include <immintrin.h>
+  #endif
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace Fixpp
+{
+
+    namespace simd
+    {
+
+        namespace details
+        {
+
+            inline unsigned countTrailingZeros(uint32_t mask)
+            {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return static_cast<unsigned>(index);
+#else
+                return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+            }
+
+            inline unsigned countTrailingZeros64(uint64_t mask)
+            {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward64(&index, mask);
+                return static_cast<unsigned>(index);
+#else
+                return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+            }
+
+            inline const char* findScalar(const char* first, const char* last, char c)
+            {
+                while (first != last && *first != c)
+                    ++first;
+
+                return first;
+            }
+
+#if defined(FIXPP_SIMD_SSE2)
+            inline const char* findSSE2(const char* first, const char* last, char c)
+            {
+                const __m128i needle = _mm_set1_epi8(c);
+
+                while (last - first >= 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+                    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+                    if (mask != 0)
+                        return first + countTrailingZeros(static_cast<uint32_t>(mask));
+
+                    first += 16;
+                }
+
+                return findScalar(first, last, c);
+            }
+#endif
+
+#if defined(FIXPP_SIMD_AVX2)
+            __attribute__((target("avx2")))
+            inline const char* findAVX2(const char* first, const char* last, char c)
+            {
+                const __m256i needle = _mm256_set1_epi8(c);
+
+                while (last - first >= 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+                    const int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+                    if (mask != 0)
+                        return first + countTrailingZeros(static_cast<uint32_t>(mask));
+
+                    first += 32;
+                }
+
+                return findSSE2(first, last, c);
+            }
+#endif
+
+            inline uint32_t sumScalar(const char* first, const char* last)
+            {
+                uint32_t sum = 0;
+                while (first != last)
+                    sum += static_cast<unsigned char>(*first++);
+
+                return sum;
+            }
+
+#if defined(FIXPP_SIMD_SSE2)
+            inline uint32_t sumSSE2(const char* first, const char* last)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                __m128i acc = _mm_setzero_si128();
+
+                while (last - first >= 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+                    acc = _mm_add_epi64(acc, _mm_sad_epu8(chunk, zero));
+                    first += 16;
+                }
+
+                alignas(16) uint64_t parts[2];
+                _mm_store_si128(reinterpret_cast<__m128i *>(parts), acc);
+
+                return static_cast<uint32_t>(parts[0] + parts[1]) + sumScalar(first, last);
+            }
+#endif
+
+#if defined(FIXPP_SIMD_AVX2)
+            __attribute__((target("avx2")))
+            inline uint32_t sumAVX2(const char* first, const char* last)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                __m256i acc = _mm256_setzero_si256();
+
+                while (last - first >= 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+                    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(chunk, zero));
+                    first += 32;
+                }
+
+                alignas(32) uint64_t parts[4];
+                _mm256_store_si256(reinterpret_cast<__m256i *>(parts), acc);
+
+                return static_cast<uint32_t>(parts[0] + parts[1] + parts[2] + parts[3]) + sumSSE2(first, last);
+            }
+#endif
+
+            // Fills one bit per byte of [first, last), set if the byte is either a or b
+            inline void bitmapScalar(const char* first, const char* last, char a, char b, uint64_t* bits)
+            {
+                while (first != last)
+                {
+                    const size_t count = last - first < 64 ? static_cast<size_t>(last - first) : 64;
+
+                    uint64_t word = 0;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if (first[i] == a || first[i] == b)
+                            word |= uint64_t(1) << i;
+                    }
+
+                    *bits++ = word;
+                    first += count;
+                }
+            }
+
+#if defined(FIXPP_SIMD_SSE2)
+            inline uint64_t bitmapSSE2Block(const char* first, __m128i va, __m128i vb)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+                const __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+                return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq)));
+            }
+
+            inline void bitmapSSE2(const char* first, const char* last, char a, char b, uint64_t* bits)
+            {
+                const __m128i va = _mm_set1_epi8(a);
+                const __m128i vb = _mm_set1_epi8(b);
+
+                while (last - first >= 64)
+                {
+                    *bits++ = bitmapSSE2Block(first, va, vb)
+                            | (bitmapSSE2Block(first + 16, va, vb) << 16)
+                            | (bitmapSSE2Block(first + 32, va, vb) << 32)
+                            | (bitmapSSE2Block(first + 48, va, vb) << 48);
+                    first += 64;
+                }
+
+                bitmapScalar(first, last, a, b, bits);
+            }
+#endif
+
+#if defined(FIXPP_SIMD_AVX2)
+            __attribute__((target("avx2")))
+            inline void bitmapAVX2(const char* first, const char* last, char a, char b, uint64_t* bits)
+            {
+                const __m256i va = _mm256_set1_epi8(a);
+                const __m256i vb = _mm256_set1_epi8(b);
+
+                while (last - first >= 64)
+                {
+                    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+                    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + 32));
+
+                    const __m256i eqLo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, va), _mm256_cmpeq_epi8(lo, vb));
+                    const __m256i eqHi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, va), _mm256_cmpeq_epi8(hi, vb));
+
+                    *bits++ = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eqLo)))
+                            | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eqHi))) << 32);
+                    first += 64;
+                }
+
+                bitmapScalar(first, last, a, b, bits);
+            }
+#endif
+
+            struct Kernels
+            {
+                const char* (*find)(const char*, const char*, char);
+                uint32_t (*sum)(const char*, const char*);
+                void (*bitmap)(const char*, const char*, char, char, uint64_t*);
+            };
+
+            inline Kernels selectKernels()
+            {
+#if defined(FIXPP_SIMD_AVX2)
+                if (__builtin_cpu_supports("avx2"))
+                    return Kernels { &findAVX2, &sumAVX2, &bitmapAVX2 };
+#endif
+#if defined(FIXPP_SIMD_SSE2)
+                return Kernels { &findSSE2, &sumSSE2, &bitmapSSE2 };
+#else
+                return Kernels { &findScalar, &sumScalar, &bitmapScalar };
+#endif
+            }
+
+            inline const Kernels& kernels()
+            {
+                static const Kernels selected = selectKernels();
+                return selected;
+            }
+
+        } // namespace details
+
+        // Returns a pointer to the first occurence of c in [first, last) or last if
+        // c could not be found
+
+        inline const char* find(const char* first, const char* last, char c)
+        {
+            return details::kernels().find(first, last, c);
+        }
+
+        // Returns the sum of all bytes in [first, last)
+
+        inline uint32_t sum(const char* first, const char* last)
+        {
+            return details::kernels().sum(first, last);
+        }
+
+        // Fills bits with one bit per byte of [first, last), set if the byte is either a or b.
+        // bits must be able to hold (last - first + 63) / 64 words
+
+        inline void bitmap(const char* first, const char* last, char a, char b, uint64_t* bits)
+        {
+            details::kernels().bitmap(first, last, a, b, bits);
+        }
+
+        // Hints the CPU to bring the beginning of [first, first + size) into the cache.
+        // Only the first lines are prefetched, the hardware prefetcher takes over from there
+
+        inline void prefetch(const char* first, size_t size)
+        {
+            static constexpr size_t CacheLineSize = 64;
+            static constexpr size_t MaxLines = 4;
+
+            const size_t lines = (size + CacheLineSize - 1) / CacheLineSize;
+            for (size_t i = 0; i < lines && i < MaxLines; ++i)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(first + i * CacheLineSize);
+#elif defined(FIXPP_SIMD_SSE2)
+                _mm_prefetch(first + i * CacheLineSize, _MM_HINT_T0);
+#endif
+            }
+        }
+
+    } // namespace simd
+
+} // namespace Fixpp
@@ -0,0 +1,169 @@
+/* swar.h
+
+  SWAR (SIMD Within A Register) kernels used to decode numeric values.
+
+  Numbers in a FIX frame are written as plain ASCII digits. Instead of
+  converting them one byte at a time, the kernels below load 8 bytes in a
+  64-bit register, check that they all are digits and convert them with
+  three multiplications.
+
+  Bytes are loaded in memory order, the first byte of the chunk being the
+  least significant byte of the register.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace Fixpp
+{
+
+    namespace swar
+    {
+
+        // Loads 8 bytes, the first one being the least significant
+        inline uint64_t load8(const char* p)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, p, sizeof chunk);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            chunk = __builtin_bswap64(chunk);
+#endif
+            return chunk;
+        }
+
+        // A mask with a non-zero byte for every byte of the chunk that is not a digit.
+        // Bytes past the first non-digit byte might be wrongly flagged, which is why
+        // only the lowest non-zero byte should be relied on
+        inline uint64_t nonDigits8(uint64_t chunk)
+        {
+            return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+                   ^ 0x3333333333333333ULL;
+        }
+
+        inline bool isDigits8(uint64_t chunk)
+        {
+            return nonDigits8(chunk) == 0;
+        }
+
+        // Number of leading bytes of the chunk that are digits
+        inline unsigned countDigits8(uint64_t chunk)
+        {
+            const uint64_t mask = nonDigits8(chunk);
+            if (mask == 0)
+                return 8;
+
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return static_cast<unsigned>(index) / 8;
+#else
+            return static_cast<unsigned>(__builtin_ctzll(mask)) / 8;
+#endif
+        }
+
+        // Converts 8 digits, the first one being the most significant
+        inline uint32_t parse8(uint64_t chunk)
+        {
+            chunk -= 0x3030303030303030ULL;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                     (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+            return static_cast<uint32_t>(chunk);
+        }
+
+        // Parses the run of digits that starts at first, never reading past last. The run
+        // is located through the digit mask of the first chunks, which are converted as a
+        // whole. Returns the number of digits that have been parsed, 0 when first is not a
+        // digit or when the value does not fit in max
+        inline size_t parseUnsigned(const char* first, const char* last, uint64_t max, uint64_t* value)
+        {
+            static constexpr uint64_t Zeros = 0x3030303030303030ULL;
+            static constexpr uint64_t Powers[] = {
+                1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+            };
+
+            const char* p = first;
+            uint64_t result = 0;
+
+            for (;;)
+            {
+                // Past two chunks, or close to the end, digits are parsed one by one
+                if (last - p < 8 || p - first > 8)
+                {
+                    while (p != last && static_cast<unsigned char>(*p - '0') < 10)
+                    {
+                        const unsigned digit = static_cast<unsigned>(*p - '0');
+                        if (result > (UINT64_MAX - digit) / 10)
+                            return 0;
+
+                        result = result * 10 + digit;
+                        ++p;
+                    }
+
+                    break;
+                }
+
+                const uint64_t chunk = load8(p);
+                const unsigned count = countDigits8(chunk);
+
+                if (count == 8)
+                {
+                    result = result * Powers[8] + parse8(chunk);
+                    p += 8;
+                    continue;
+                }
+
+                // Moves the digits to the most significant bytes and pads them with leading zeros
+                if (count > 0)
+                {
+                    result = result * Powers[count] + parse8((chunk << (8 * (8 - count))) | (Zeros >> (8 * count)));
+                    p += count;
+                }
+
+                break;
+            }
+
+            if (p == first || result > max)
+                return 0;
+
+            *value = result;
+            return static_cast<size_t>(p - first);
+        }
+
+        // Parses the digits in [first, last) into value, stopping at the first byte that
+        // is not a digit. Returns a pointer to that byte. The number of digits that
+        // have been parsed is added to count, value overflowing when count exceeds 19
+        inline const char* parseDigits(const char* first, const char* last, uint64_t& value, size_t& count)
+        {
+            const char* p = first;
+
+            while (last - p >= 8)
+            {
+                const uint64_t chunk = load8(p);
+                if (!isDigits8(chunk))
+                    break;
+
+                value = value * 100000000ULL + parse8(chunk);
+                p += 8;
+            }
+
+            while (p != last && static_cast<unsigned char>(*p - '0') < 10)
+            {
+                value = value * 10 + static_cast<unsigned>(*p - '0');
+                ++p;
+            }
+
+            count += static_cast<size_t>(p - first);
+            return p;
+        }
+
+    } // namespace swar
+
+} // namespace Fixpp
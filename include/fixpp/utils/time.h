@@ -6,47 +6,84 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 
-// converts a tm represented as UTC to a time_t in UTC
+namespace Fixpp
+{
 
-inline std::time_t mkgmtime(const struct std::tm* ptm)
+namespace civil
 {
-    static constexpr auto SecondsPerMinute = 60;
-    static constexpr auto SecondsPerHour = 3600;
-    static constexpr auto SecondsPerDay = 86400;
 
-    static constexpr int DaysOfMonth[12] = {
+constexpr bool isLeapYear(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+constexpr unsigned daysInMonth(int year, unsigned month)
+{
+    constexpr unsigned char Days[12] = {
         31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
     };
 
-    auto isLeapYear = [](int year)
-    {
-        if (year % 4 != 0)
-            return false;
-        if (year % 100 != 0)
-            return true;
+    return month == 2 && isLeapYear(year) ? 29 : Days[month - 1];
+}
 
-        return (year % 400) == 0;
-    };
+// Number of days between 1970-01-01 and the given date of the proleptic Gregorian
+// calendar (month and day are 1-indexed), through the closed-form days_from_civil
+// algorithm described by Howard Hinnant
+
+constexpr int64_t daysFromCivil(int year, unsigned month, unsigned day)
+{
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);                 // [0, 399]
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                   // [0, 146096]
+    return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+struct YearMonthDay
+{
+    int year;
+    unsigned month;
+    unsigned day;
+};
+
+// Inverse of daysFromCivil, through Howard Hinnant's civil_from_days algorithm
+
+constexpr YearMonthDay civilFromDays(int64_t days)
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);                // [0, 146096]
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;    // [0, 399]
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                  // [0, 365]
+    const unsigned mp = (5 * doy + 2) / 153;                                       // [0, 11]
+    const unsigned day = doy - (153 * mp + 2) / 5 + 1;                             // [1, 31]
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;                              // [1, 12]
+    return { static_cast<int>(static_cast<int64_t>(yoe) + era * 400) + (month <= 2), month, day };
+}
+
+} // namespace civil
+
+} // namespace Fixpp
+
+// converts a tm represented as UTC to a time_t in UTC
+
+inline std::time_t mkgmtime(const struct std::tm* ptm)
+{
+    static constexpr auto SecondsPerMinute = 60;
+    static constexpr auto SecondsPerHour = 3600;
+    static constexpr auto SecondsPerDay = 86400;
 
     std::time_t secs = 0;
-    int year = ptm->tm_year + 1900;
-    for (int y = 1970; y < year; ++y)
-        secs += (isLeapYear(y) ? 366 : 365) * SecondsPerDay;
-    for (int m = 0; m < ptm->tm_mon; ++m)
-    {
-        secs += DaysOfMonth[m] * SecondsPerDay;
-        if (m == 1 && isLeapYear(year))
-            secs += SecondsPerDay;
-    }
 
     // ptm may reprensent a time only
     if (ptm->tm_mday)
-        secs += (ptm->tm_mday - 1) * SecondsPerDay;
+        secs += Fixpp::civil::daysFromCivil(ptm->tm_year + 1900, static_cast<unsigned>(ptm->tm_mon + 1), static_cast<unsigned>(ptm->tm_mday)) * SecondsPerDay;
     secs += ptm->tm_hour       * SecondsPerHour;
     secs += ptm->tm_min        * SecondsPerMinute;
     secs += ptm->tm_sec;
     return secs;
 }
-
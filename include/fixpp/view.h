@@ -6,16 +6,56 @@
 
 #pragma once
 
+#include <string_view>
 #include <utility>
 
 namespace Fixpp
 {
 
-    // @Todo use string_view when available
-    using View = std::pair<const char*, size_t>;
+    // A pair of a pointer and a size that converts to a std::string_view
+
+    struct View : public std::pair<const char*, size_t>
+    {
+        using std::pair<const char*, size_t>::pair;
+
+        View() = default;
+
+        View(const std::pair<const char*, size_t>& other)
+            : std::pair<const char*, size_t>(other)
+        { }
+
+        View(std::string_view str)
+            : std::pair<const char*, size_t>(str.data(), str.size())
+        { }
+
+        const char* data() const
+        {
+            return first;
+        }
+
+        size_t size() const
+        {
+            return second;
+        }
+
+        bool empty() const
+        {
+            return second == 0;
+        }
+
+        std::string_view str() const
+        {
+            return std::string_view(first, second);
+        }
+
+        operator std::string_view() const
+        {
+            return str();
+        }
+    };
 
     inline View make_view(const char* data, size_t size)
     {
-        return std::make_pair(data, size);
+        return View(data, size);
     }
 }
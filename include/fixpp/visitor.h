@@ -6,19 +6,32 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include <fixpp/tag.h>
+#include <fixpp/utils/arena.h>
 #include <fixpp/utils/cursor.h>
 #include <fixpp/utils/result.h>
+#include <fixpp/utils/simd.h>
 #include <fixpp/utils/soh.h>
+#include <fixpp/utils/swar.h>
 #include <fixpp/meta.h>
 #include <fixpp/view.h>
+#include <fixpp/index.h>
 #include <fixpp/dsl.h>
 #include <fixpp/dsl/details/flatten.h>
 #include <fixpp/dsl/details/lexical_cast.h>
+#include <fixpp/dsl/details/tag_table.h>
 
 namespace Fixpp
 {
@@ -29,6 +42,12 @@ namespace Fixpp
     // ------------------------------------------------
 
     // Encapsulates types of errors that can occur during parsing.
+    //
+    // Along with its type and column, an error records the offending tag, if known,
+    // and a view into the frame pointing at the offending bytes. The message is either
+    // formatted when the error occurs or, when the LeanErrors rule is on, lazily built
+    // from the type, tag and view when asString() is called. In that case, the frame
+    // must still be alive when calling asString()
 
     struct ErrorKind
     {
@@ -38,6 +57,16 @@ namespace Fixpp
         ErrorKind(Type type, size_t column, std::string str)
             : type_(type)
             , column_(column)
+            , tag_(0)
+            , view_(nullptr, 0)
+            , str_(std::move(str))
+        { }
+
+        ErrorKind(Type type, size_t column, int tag, View view, std::string str = std::string())
+            : type_(type)
+            , column_(column)
+            , tag_(tag)
+            , view_(view)
             , str_(std::move(str))
         { }
 
@@ -48,7 +77,10 @@ namespace Fixpp
 
         std::string asString() const
         {
-            return str_;
+            if (!str_.empty())
+                return str_;
+
+            return format();
         }
 
         size_t column() const
@@ -56,9 +88,71 @@ namespace Fixpp
             return column_;
         }
 
+        // The offending tag, 0 when the error is not related to a specific tag
+        int tag() const
+        {
+            return tag_;
+        }
+
+        View view() const
+        {
+            return view_;
+        }
+
     private:
+        static const char* describe(Type type)
+        {
+            switch (type)
+            {
+            case Incomplete:
+                return "Incomplete frame";
+            case ParsingError:
+                return "Parsing error";
+            case UnknownTag:
+                return "Encountered unknown tag";
+            case UnknownMessage:
+                return "Unknown MsgType";
+            case InvalidVersion:
+                return "FIX version mismatched";
+            case InvalidTag:
+                return "Invalid tag";
+            case InvalidChecksum:
+                return "Invalid CheckSum";
+            case InvalidLength:
+                return "Invalid BodyLength";
+            }
+
+            return "Unknown error";
+        }
+
+        std::string format() const
+        {
+            std::string str(describe(type_));
+
+            char buf[32];
+            if (tag_ != 0)
+            {
+                auto count = std::snprintf(buf, sizeof buf, " %d", tag_);
+                str.append(buf, count);
+            }
+
+            auto count = std::snprintf(buf, sizeof buf, " at column %zu", column_);
+            str.append(buf, count);
+
+            if (view_.second > 0)
+            {
+                str += ", got '";
+                str.append(view_.first, view_.second);
+                str += "'";
+            }
+
+            return str;
+        }
+
         Type type_;
         size_t column_;
+        int tag_;
+        View view_;
         std::string str_;
     };
 
@@ -79,15 +173,58 @@ namespace Fixpp
             : empty_(true)
         { }
 
+        Deferred(const Deferred& other)
+            : empty_(true)
+        {
+            if (!other.empty_)
+                construct(other.get());
+        }
+
+        Deferred(Deferred&& other)
+            : empty_(true)
+        {
+            if (!other.empty_)
+                construct(std::move(*other.operator->()));
+        }
+
+        Deferred& operator=(const Deferred& other)
+        {
+            if (this != &other)
+                assign(other);
+            return *this;
+        }
+
+        Deferred& operator=(Deferred&& other)
+        {
+            if (this != &other)
+                assign(std::move(other));
+            return *this;
+        }
+
+        ~Deferred()
+        {
+            reset();
+        }
+
         typedef typename std::aligned_storage<sizeof (T), alignof (T)>::type Storage;
 
         template<typename... Args>
         void construct(Args&& ...args)
         {
+            reset();
             new (&storage_) T(std::forward<Args>(args)...);
             empty_ = false;
         }
 
+        void reset()
+        {
+            if (!empty_)
+            {
+                reinterpret_cast<T *>(&storage_)->~T();
+                empty_ = true;
+            }
+        }
+
         bool isEmpty() const
         {
             return empty_;
@@ -112,6 +249,23 @@ namespace Fixpp
         }
 
     private:
+        // The value is constructed anew rather than assigned to, as T might not be assignable
+        void assign(const Deferred& other)
+        {
+            if (other.empty_)
+                reset();
+            else
+                construct(other.get());
+        }
+
+        void assign(Deferred&& other)
+        {
+            if (other.empty_)
+                reset();
+            else
+                construct(std::move(*other.operator->()));
+        }
+
         Storage storage_;
         bool empty_;
     };
@@ -123,25 +277,44 @@ namespace Fixpp
     // Keeps information related to the current parsing context like
     // MsgType or version and encapsulates the parsing error if any
 
+    template<typename CursorT>
     struct ParsingContext
     {
-        ParsingContext(StreamCursor& cursor)
+        using Cursor = CursorT;
+        using Token = typename Cursor::Token;
+        using Revert = typename Cursor::Revert;
+
+        ParsingContext(Cursor& cursor)
             : cursor(cursor)
+            , leanErrors(false)
+            , bodyLength(0)
+            , trailer(nullptr)
             , sum(0)
         { }
 
         void setError(ErrorKind::Type type, const char* errFmt, ...)
         {
-            auto column = static_cast<size_t>(cursor);
+            va_list args;
+            va_start(args, errFmt);
+            setErrorV(type, 0, currentField(), errFmt, args);
+            va_end(args);
+        }
 
-            char errStr[255];
-            std::memset(errStr, 0, sizeof errStr);
+        // Same as setError() for an error that relates to a given tag and, when
+        // view is not empty, to a given part of the frame
+        void setTagError(ErrorKind::Type type, int tag, View view, const char* errFmt, ...)
+        {
             va_list args;
             va_start(args, errFmt);
-            auto count = std::vsnprintf(errStr, sizeof errStr, errFmt, args);
+            setErrorV(type, tag, view.second > 0 ? view : currentField(), errFmt, args);
             va_end(args);
+        }
 
-            error.construct(type, column, std::string(errStr, count));
+        // When lean errors are enabled, the error message is not formatted until
+        // asked for, which makes setting an error allocation-free
+        void setLeanErrors(bool lean)
+        {
+            leanErrors = lean;
         }
 
         bool hasError() const
@@ -149,11 +322,27 @@ namespace Fixpp
             return !error.isEmpty();
         }
 
+        // Resets the context so that it can be used to parse a new frame
+        void reset()
+        {
+            error.reset();
+            version = View();
+            bodyLength = 0;
+            msgType = View();
+            trailer = nullptr;
+            sum = 0;
+        }
+
         void setBodyLength(int length)
         {
             bodyLength = length;
         }
 
+        void setTrailer(const char* offset)
+        {
+            trailer = offset;
+        }
+
         void setMsgType(const View& view)
         {
             msgType = view;
@@ -164,14 +353,53 @@ namespace Fixpp
             version = view;
         }
 
-        StreamCursor& cursor;
+        Cursor& cursor;
         Deferred<ErrorKind> error;
+        bool leanErrors;
 
         View version;
         int bodyLength;
         View msgType;
 
+        // Offset of the CheckSum field, known upfront when the
+        // frame has been framed through its BodyLength
+        const char* trailer;
+
         size_t sum;
+
+    private:
+        // Maximum number of bytes of the frame referenced by an error
+        static constexpr size_t MaxErrorView = 32;
+
+        // The field the cursor is currently on, up to the next delimiter
+        View currentField() const
+        {
+            const char* first = cursor.offset();
+            const size_t size = std::min(cursor.remaining(), MaxErrorView);
+
+            const void* soh = std::memchr(first, SOH, size);
+            return View(first, soh != nullptr ? static_cast<const char*>(soh) - first : size);
+        }
+
+        void setErrorV(ErrorKind::Type type, int tag, View view, const char* errFmt, va_list args)
+        {
+            auto column = static_cast<size_t>(cursor);
+
+            if (leanErrors)
+            {
+                error.construct(type, column, tag, view);
+                return;
+            }
+
+            char errStr[255];
+            auto count = std::vsnprintf(errStr, sizeof errStr, errFmt, args);
+            if (count < 0)
+                count = 0;
+            else if (static_cast<size_t>(count) >= sizeof errStr)
+                count = sizeof errStr - 1;
+
+            error.construct(type, column, tag, view, std::string(errStr, count));
+        }
     };
 
     // ------------------------------------------------
@@ -182,13 +410,13 @@ namespace Fixpp
     // the return type of the visitor when used through visit()
     // or the value of the tag when used through visitTag<T>()
 
-    template<typename T>
-    struct TypedParsingContext : public ParsingContext
+    template<typename T, typename Cursor = RawCursor>
+    struct TypedParsingContext : public ParsingContext<Cursor>
     {
         using Type = T;
 
-        TypedParsingContext(StreamCursor& cursor)
-            : ParsingContext(cursor)
+        TypedParsingContext(Cursor& cursor)
+            : ParsingContext<Cursor>(cursor)
         { }
 
         void setValue(T value)
@@ -198,8 +426,8 @@ namespace Fixpp
 
         VisitError<T> toVisitError() const
         {
-            if (hasError())
-                return result::Err(error.get());
+            if (this->hasError())
+                return result::Err(this->error.get());
             return result::Ok(resultValue.get());
         }
 
@@ -208,23 +436,40 @@ namespace Fixpp
 
     // Specialization for a void result
 
-    template<>
-    struct TypedParsingContext<void> : public ParsingContext
+    template<typename Cursor>
+    struct TypedParsingContext<void, Cursor> : public ParsingContext<Cursor>
     {
         using Type = void;
 
-        TypedParsingContext(StreamCursor& cursor)
-            : ParsingContext(cursor)
+        TypedParsingContext(Cursor& cursor)
+            : ParsingContext<Cursor>(cursor)
         { }
 
         VisitError<void> toVisitError() const
         {
-            if (hasError())
-                return result::Err(error.get());
+            if (this->hasError())
+                return result::Err(this->error.get());
             return result::Ok();
         }
     };
 
+    // ------------------------------------------------
+    // Projection
+    // ------------------------------------------------
+
+    // A compile-time list of the tags that a Visitor reads. A Projection is attached
+    // either to the VisitRules or to the Visitor itself through a Projection typedef,
+    // the Visitor one taking precedence. Only the projected fields of the Header and
+    // Message are then parsed, every other field being skipped without being stored.
+    // Fields that have been skipped behave as if they were absent from the frame.
+    //
+    // Tags wrapped in StopAfter end the parsing of the frame as soon as every one of
+    // them has been seen
+
+    template<typename Tag> struct StopAfter { };
+
+    template<typename... Tags> struct Projection { };
+
     namespace impl
     {
 
@@ -238,6 +483,49 @@ namespace Fixpp
             template<typename T> using HasValidateLength = decltype(&T::ValidateLength);
             template<typename T> using HasStrictMode = decltype(&T::StrictMode);
             template<typename T> using HasSkipUnknownTags = decltype(&T::SkipUnknownTags);
+            template<typename T> using HasSkipUnhandledMessages = decltype(&T::SkipUnhandledMessages);
+
+            // Optional rule: when true, messages that are only handled by the catch-all
+            // overload of the Visitor are not parsed, unless in StrictMode
+            template<typename Rules, bool = meta::is_detected<HasSkipUnhandledMessages, Rules>::value>
+            struct SkipUnhandledMessages : public std::false_type
+            {
+            };
+
+            template<typename Rules>
+            struct SkipUnhandledMessages<Rules, true> : public std::integral_constant<bool, Rules::SkipUnhandledMessages>
+            {
+            };
+
+            template<typename T> using HasProjection = typename T::Projection;
+            template<typename T> using HasReuseMessages = decltype(&T::ReuseMessages);
+
+            // Optional rule: when true, the Header and Message handed to the Visitor are
+            // cached per thread and reused from one frame to another instead of being
+            // constructed for every frame
+            template<typename Rules, bool = meta::is_detected<HasReuseMessages, Rules>::value>
+            struct ReuseMessages : public std::false_type
+            {
+            };
+
+            template<typename Rules>
+            struct ReuseMessages<Rules, true> : public std::integral_constant<bool, Rules::ReuseMessages>
+            {
+            };
+
+            template<typename T> using HasLeanErrors = decltype(&T::LeanErrors);
+
+            // Optional rule: when true, parsing errors are recorded without formatting
+            // their message, which is only built when asked for through ErrorKind::asString()
+            template<typename Rules, bool = meta::is_detected<HasLeanErrors, Rules>::value>
+            struct LeanErrors : public std::false_type
+            {
+            };
+
+            template<typename Rules>
+            struct LeanErrors<Rules, true> : public std::integral_constant<bool, Rules::LeanErrors>
+            {
+            };
 
             template<typename Overrides>
             struct OverridesValidator;
@@ -256,12 +544,104 @@ namespace Fixpp
 
         } // namespace rules
 
+        // ------------------------------------------------
+        // projection
+        // ------------------------------------------------
+
+        namespace projection
+        {
+
+            struct None { };
+
+            template<typename Tag>
+            struct Field
+            {
+                static constexpr int Id = Tag::Id;
+                static constexpr bool Stop = false;
+            };
+
+            template<typename Tag>
+            struct Field<StopAfter<Tag>>
+            {
+                static constexpr int Id = Tag::Id;
+                static constexpr bool Stop = true;
+            };
+
+            template<typename Projection> struct Traits;
+
+            template<typename... Tags>
+            struct Traits<Projection<Tags...>>
+            {
+                static constexpr size_t Size = sizeof...(Tags);
+                static constexpr size_t StopCount = (size_t(0) + ... + (Field<Tags>::Stop ? 1 : 0));
+
+                using Table = Fixpp::details::TagTable<Field<Tags>::Id...>;
+
+                static bool stops(size_t index)
+                {
+                    static constexpr bool Stops[] = { Field<Tags>::Stop... };
+                    return Stops[index];
+                }
+            };
+
+            template<typename Visitor, typename Rules>
+            using ProjectionFor = meta::detected_or_t<
+                meta::detected_or_t<None, rules::HasProjection, Rules>,
+                rules::HasProjection, Visitor
+            >;
+
+        } // namespace projection
+
 
         template<typename T> struct id { };
 
         template<typename Message, typename Overrides> using OverrideFor
             = typename meta::map::ops::atOr<Overrides, Message, Message>::type::Ref;
 
+        // ------------------------------------------------
+        // HandlesMessage
+        // ------------------------------------------------
+
+        // Tells whether a Visitor provides a dedicated overload for a Message or only
+        // handles it through its catch-all template<typename HeaderT, typename MessageT>
+        // overload.
+        //
+        // The catch-all of the Visitor is hidden by an identical template declared in a
+        // derived Probe. If the call still resolves to an overload of the Visitor, the
+        // Visitor has a dedicated overload for the Message. When the detection is not
+        // possible (final Visitor, catch-all with a different signature), the Visitor
+        // is assumed to handle the Message.
+
+        namespace overload
+        {
+            struct CatchAll { };
+
+            template<typename Visitor>
+            struct Probe : public Visitor
+            {
+                using Visitor::operator();
+
+                template<typename HeaderT, typename MessageT>
+                CatchAll operator()(HeaderT, MessageT);
+            };
+
+            template<typename Visitor, typename Header, typename Message>
+            using CallResult = decltype(std::declval<Probe<Visitor>&>()(std::declval<const Header&>(), std::declval<const Message&>()));
+
+        } // namespace overload
+
+        template<typename Visitor, typename Header, typename Message, bool = std::is_final<Visitor>::value>
+        struct HandlesMessage : public std::true_type
+        {
+        };
+
+        template<typename Visitor, typename Header, typename Message>
+        struct HandlesMessage<Visitor, Header, Message, false>
+            : public std::integral_constant<bool,
+                !std::is_same<meta::detected_t<overload::CallResult, Visitor, Header, Message>, overload::CatchAll>::value>
+        {
+        };
+
         // ------------------------------------------------
         // DictionaryVisitor
         // ------------------------------------------------
@@ -271,21 +651,60 @@ namespace Fixpp
         template<typename Header, typename Overrides>
         struct DictionaryVisitor
         {
-            template<typename Message, typename Context, typename Visitor>
-            static bool visit(const Context& context, Visitor& visitor)
+            template<typename Message, typename Visitor>
+            static void visit(Visitor& visitor)
             {
-                auto msgType = context.msgType.first;
-                auto msgTypeSize = context.msgType.second;
-                if (Message::MsgType::equals(msgType, msgTypeSize))
-                {
-                    visitor(id<Header> { }, id<OverrideFor<Message, Overrides>> {});
-                    return true;
-                }
+                visitor(id<Header> { }, id<OverrideFor<Message, Overrides>> {});
+            }
+        };
 
-                return false;
+        // ------------------------------------------------
+        // DispatchTable
+        // ------------------------------------------------
+
+        // Maps the packed key of a MsgType (see chars.h) to the 1-based index
+        // of the corresponding message inside the Dictionary, 0 meaning that
+        // the MsgType is not part of the Dictionary.
+        //
+        // The table is computed at compile-time once per Dictionary. If a message
+        // appears more than once in the Dictionary, the first one wins.
+
+        template<typename Messages>
+        struct DispatchTable
+        {
+            static constexpr size_t Size = meta::typelist::ops::Length<Messages>::value;
+            static_assert(Size < 256, "Too many messages in Dictionary");
+
+            struct Slots
+            {
+                uint8_t index[char_traits::KeySize];
+            };
+
+            template<size_t... Indexes>
+            static constexpr Slots make(meta::seq::index_sequence<Indexes...>)
+            {
+                const unsigned keys[] = {
+                    0, meta::typelist::ops::At<Indexes, Messages>::Result::MsgType::Key...
+                };
+
+                Slots slots {};
+                for (size_t i = sizeof...(Indexes); i > 0; --i)
+                    slots.index[keys[i]] = static_cast<uint8_t>(i);
+
+                return slots;
+            }
+
+            static constexpr Slots Value = make(meta::seq::make_index_sequence<Size>{});
+
+            static size_t of(const View& msgType)
+            {
+                return Value.index[char_traits::key(msgType.first, msgType.second)];
             }
         };
 
+        template<typename Messages>
+        constexpr typename DispatchTable<Messages>::Slots DispatchTable<Messages>::Value;
+
         enum class VisitStatus
         {
             Ok,              // The version matched and the message has been found
@@ -293,13 +712,26 @@ namespace Fixpp
             NotFound         // The version matched but the message could not be found in the typelist
         };
 
+        template<typename Messages, typename MessageVisitor, typename Visitor, size_t... Indexes>
+        void dispatchMessage(size_t index, Visitor& visitor, meta::seq::index_sequence<Indexes...>)
+        {
+            using Thunk = void (*)(Visitor&);
+            static constexpr Thunk Thunks[] = {
+                &MessageVisitor::template visit<typename meta::typelist::ops::At<Indexes, Messages>::Result, Visitor>...
+            };
+
+            Thunks[index](visitor);
+        }
+
         // Every FIX version has a special Spec namespace that provides a list of structure
         // that represent a specific version of FIX. The Dictionary struct regroups the list
         // of all valid messages for a specific FIX version as well as the Version type itself.
         //
         // All valid messages for a version are encoded through a meta::typelist. Thus, at
-        // run-time, after parsing the MsgType, we visit all the messages from the typelist
-        // of the specific version until we find the corresponding one.
+        // compile-time, we build a DispatchTable from the typelist of the specific version
+        // as well as a table of thunks, one per message. At run-time, after parsing the MsgType,
+        // the message is found through a single lookup in the table, no matter how many messages
+        // the Dictionary holds.
         //
         // That way, we only need to add new messages in this special typelist to make
         // them visible from the visitor
@@ -317,14 +749,16 @@ namespace Fixpp
             auto versionSize = context.version.second;
 
             using MessageVisitor = DictionaryVisitor<Header, Overrides>;
+            using Table = DispatchTable<Messages>;
 
             if (Version::equals(version, versionSize))
             {
-                using AllMessagesVisitor = meta::typelist::ops::Visitor<Messages, MessageVisitor>;
-                if (AllMessagesVisitor::visit(context, visitor))
-                    return VisitStatus::Ok;
+                const auto index = Table::of(context.msgType);
+                if (index == 0)
+                    return VisitStatus::NotFound;
 
-                return VisitStatus::NotFound;
+                dispatchMessage<Messages, MessageVisitor>(index - 1, visitor, meta::seq::make_index_sequence<Table::Size>{});
+                return VisitStatus::Ok;
             }
 
             return VisitStatus::VersionMismatch;
@@ -341,55 +775,19 @@ namespace Fixpp
 
             if (status == VisitStatus::VersionMismatch)
             {
-                std::string versionStr(context.version.first, context.version.second);
-
-                context.setError(ErrorKind::InvalidVersion, "FIX version mismatched, expected '%s', got '%s'",
-                        Version::Str, versionStr.c_str());
+                context.setTagError(ErrorKind::InvalidVersion, Tag::BeginString::Id, context.version,
+                        "FIX version mismatched, expected '%s', got '%.*s'",
+                        Version::Str, static_cast<int>(context.version.second), context.version.first);
             }
             else if (status == VisitStatus::NotFound)
             {
-                std::string versionStr(context.version.first, context.version.second);
-                std::string msgTypeStr(context.msgType.first, context.msgType.second);
-
-                context.setError(ErrorKind::UnknownMessage, "Unknown MsgType(%s) for FIX version %s", msgTypeStr.c_str(), versionStr.c_str());
-            }
-        }
-
-        template<size_t Index, typename Field, typename Visitor>
-        void doVisitSingleField(unsigned tag, Field& field, Visitor& visitor, int* index)
-        {
-            if (tag == field.tag())
-            {
-                visitor(field);
-                *index = Index;
+                context.setTagError(ErrorKind::UnknownMessage, Tag::MsgType::Id, context.msgType,
+                        "Unknown MsgType(%.*s) for FIX version %.*s",
+                        static_cast<int>(context.msgType.second), context.msgType.first,
+                        static_cast<int>(context.version.second), context.version.first);
             }
         }
 
-        template<typename Message, typename Visitor, size_t... Indexes>
-        bool doVisitField(Message& message, unsigned tag, Visitor& visitor,
-                          meta::seq::index_sequence<Indexes...>)
-        {
-            int index = -1;
-            int dummy[] = {0, (doVisitSingleField<Indexes>(tag, meta::get<Indexes>(message.values), visitor, &index), 0)...};
-
-            (void) dummy;
-            (void) tag;
-            (void) visitor;
-
-            if (index != -1)
-                message.allBits.set(static_cast<size_t>(index));
-
-            return index != -1;
-        }
-
-        template<typename Message, typename Visitor>
-        bool visitField(Message& message, unsigned tag, Visitor& visitor)
-        {
-            static constexpr size_t Size = Message::TotalTags;
-            return doVisitField(message, tag, visitor, meta::seq::make_index_sequence<Size>{});
-        }
-
-
 #define TRY_ADVANCE(fmt, ...)                                                    \
     do {                                                                         \
         if (!cursor.advance(1))                                                  \
@@ -428,8 +826,11 @@ namespace Fixpp
         {
             using Return = char;
 
-            static bool matchValue(Return* value, StreamCursor& cursor)
+            template<typename Cursor>
+            static bool matchValue(Return* value, Cursor& cursor)
             {
+                if (cursor.eof()) return false;
+
                 *value = cursor.current();
                 cursor.advance(1);
                 return true;
@@ -441,9 +842,10 @@ namespace Fixpp
         {
             using Return = View;
 
-            static bool matchValue(Return* value, StreamCursor& cursor)
+            template<typename Cursor>
+            static bool matchValue(Return* value, Cursor& cursor)
             {
-                StreamCursor::Token valueToken(cursor);
+                typename Cursor::Token valueToken(cursor);
                 if (!match_until_fast(SOH, cursor)) return false;
 
                 *value = valueToken.view(); 
@@ -456,7 +858,8 @@ namespace Fixpp
         {
             using Return = int;
 
-            static bool matchValue(Return* value, StreamCursor& cursor)
+            template<typename Cursor>
+            static bool matchValue(Return* value, Cursor& cursor)
             {
                 int val;
                 if (!match_int_fast(&val, cursor)) return false;
@@ -468,14 +871,15 @@ namespace Fixpp
 
         template<
             typename Tag,
-            typename Ret = typename TagMatcher<typename Tag::Type>::Return>
-        std::pair<bool, Ret> matchTag(StreamCursor& cursor)
+            typename Ret = typename TagMatcher<typename Tag::Type>::Return,
+            typename Cursor>
+        std::pair<bool, Ret> matchTag(Cursor& cursor)
         {
             #define TRY_MATCH(...) \
             if (!__VA_ARGS__) \
                return std::make_pair(false, Ret {})
 
-            StreamCursor::Revert revert(cursor);
+            typename Cursor::Revert revert(cursor);
 
             int tag;
             TRY_MATCH(match_int_fast(&tag, cursor));
@@ -499,44 +903,6 @@ namespace Fixpp
         namespace details
         {
 
-             template<typename T, size_t Size>
-             struct const_array
-             {
-                 T arr[Size];
-
-                 constexpr const T& operator[](size_t index) const
-                 {
-                     return arr[index];
-                 }
-
-                 constexpr const T* begin() const { return arr; }
-                 constexpr const T* end() const { return arr + Size; }
-             };
-
-             // return the index of the smallest element
-             template<typename T, size_t Size>
-             constexpr size_t const_min_index(const const_array<T, Size>& arr, size_t offset, size_t cur)
-             {
-                 return Size == offset ? cur :
-                                        const_min_index(arr, offset + 1, arr[cur] < arr[offset] ? cur : offset);
-             }
-
-             // copy the array but with the elements at `index0` and `index1` swapped
-             template<typename T, size_t Size, size_t... Is>
-             constexpr const_array<T, Size> const_swap(const const_array<T, Size>& arr, size_t index0, size_t index1, meta::seq::index_sequence<Is...>)
-             {
-                  return {{arr[Is == index0 ? index1 : Is == index1 ? index0 : Is]...}};
-             }
-
-            // the selection sort algorithm
-            template<typename T, size_t Size>
-            constexpr const_array<T, Size> const_selection_sort(const const_array<T, Size>& arr, size_t cur = 0)
-            {
-                return cur == Size ? arr :
-                                     const_selection_sort(
-                                           const_swap(arr, cur, const_min_index(arr, cur, cur), meta::seq::make_index_sequence<Size>{}), cur+1 );
-            }
-
             template<typename Tag>
             struct IndexOf
             {
@@ -567,55 +933,31 @@ namespace Fixpp
                 static constexpr int Value = GroupTag::Id;
             };
 
-            template<typename Pack> struct IndexesImpl;
+            // Builds the TagTable of a flattened pack of tags
+
+            template<typename Pack> struct MakePackTagTable;
 
             template<typename... Tags>
-            struct IndexesImpl<meta::pack::Pack<Tags...>>
+            struct MakePackTagTable<meta::pack::Pack<Tags...>>
             {
-                static constexpr const_array<int, sizeof...(Tags)> Value = {
-                    IndexOf<Tags>::Value...
-                };
-
-                static constexpr const_array<int, sizeof...(Tags)> Sorted = const_selection_sort(Value);
-
-                static constexpr size_t Size = sizeof...(Tags);
-                static constexpr int Max = Sorted[Size - 1];
+                using Result = Fixpp::details::TagTable<IndexOf<Tags>::Value...>;
+            };
 
-                static int64_t of(int tag)
-                {
-                    //return of_rec(tag, 0);
-                    return of_binary_search(tag);
-                }
+            // Builds the TagTable of a Message from its flattened list of tags.
+            // Indexes in the table are the indexes of the fields inside the Message tuple
 
-            private:
-                static int64_t of_binary_search(int tag)
-                {
-                    int64_t low = 0;
-                    int64_t high = Size - 1;
-                    while (low <= high) {
-                       auto mid = (low + high) / 2;
-                       if (Sorted[mid] == tag) return mid;
-                       else if (Sorted[mid] < tag) low = mid + 1;
-                       else high = mid - 1;
-                    }
-                    return -1;
-                }
+            template<typename List, int... Ids>
+            struct MakeTagTable;
 
-                static constexpr int64_t of_rec(int tag, int64_t index)
-                {
-                    return (index == Size ? -1 :
-                                (Sorted[index] == tag ? index : of_rec(tag, index + 1)));
-                }
+            template<int... Ids>
+            struct MakeTagTable<meta::typelist::NullType, Ids...>
+            {
+                using Result = Fixpp::details::TagTable<Ids...>;
             };
 
-            template<typename... Tags>
-            constexpr const_array<int, sizeof...(Tags)> IndexesImpl<meta::pack::Pack<Tags...>>::Value;
-
-            template<typename... Tags>
-            constexpr const_array<int, sizeof...(Tags)> IndexesImpl<meta::pack::Pack<Tags...>>::Sorted;
-
-            template<typename... Tags>
-            struct MakeIndexes : public IndexesImpl<typename Fixpp::details::flatten::pack::Flatten<Tags...>::Result>
+            template<typename Head, typename Tail, int... Ids>
+            struct MakeTagTable<meta::typelist::TypeList<Head, Tail>, Ids...>
+                : public MakeTagTable<Tail, Ids..., IndexOf<Head>::Value>
             {
             };
         };
@@ -626,30 +968,49 @@ namespace Fixpp
 
         // A bitset of valid tags inside a Message or RepeatingGroup
         //
-        // Note that to avoid index lookup when setting or testing
-        // the value of a particular bit in the bitset, we "allocate"
-        // a bitset large enough to hold the maximum tag value
-        // (that is, if our TagSet has a tag numbered 10453, then
-        //  our bitself will hold up to 10453 + 1 bits).
+        // Every tag is given a dense slot through a TagTable, which means
+        // that the bitset only holds one bit per field, whatever the
+        // magnitude of the tags. Looking up the slot of a tag is O(1):
+        // an array access for standard tags, a perfect hash for large
+        // (custom) tags.
         //
-        // While it should not be a problem in most cases, if tags
-        // are large enough, we might cause a stack overflow as
-        // std::bitset is using automatic (stack) storage.
+        // set() and test() expect a tag that is valid for the set. Callers
+        // that already looked up the slot of a tag through index() can
+        // use the *At() versions to avoid a second lookup.
 
         template<typename... Tags>
         struct TagSet
         {
-            // Indexes of tags in the Bitset
-            using Indexes = details::MakeIndexes<Tags...>;
+            using Table = typename details::MakePackTagTable<
+                              typename Fixpp::details::flatten::pack::Flatten<Tags...>::Result
+                          >::Result;
+
+            static constexpr size_t Size = Table::Size;
+
+            // Returns the slot of the tag or -1 if the tag is not part of the set
+            static int index(unsigned tag)
+            {
+                return Table::of(tag);
+            }
 
             void set(unsigned tag)
             {
-                bits.set(tag);
+                setAt(static_cast<size_t>(index(tag)));
             }
 
-            bool test(unsigned tag)
+            bool test(unsigned tag) const
             {
-                return bits.test(tag);
+                return testAt(static_cast<size_t>(index(tag)));
+            }
+
+            void setAt(size_t slot)
+            {
+                bits.set(slot);
+            }
+
+            bool testAt(size_t slot) const
+            {
+                return bits.test(slot);
             }
 
             void reset()
@@ -657,17 +1018,13 @@ namespace Fixpp
                 bits.reset();
             }
 
-            bool valid(unsigned tag)
+            bool valid(unsigned tag) const
             {
-                return Indexes::of(tag) != -1;
+                return index(tag) != -1;
             }
 
         private:
-            std::bitset<Indexes::Max + 1> bits;
-            // We can also use std::bitset<Indexes::Size> bits.
-            // However, with that bitset, we need to lookup the bit
-            // index for the tag any time we want to access a particular
-            // bit in the bitset.
+            std::bitset<Size> bits;
         };
 
         template<typename VersionT, typename Chars, typename... Tags>
@@ -692,80 +1049,273 @@ namespace Fixpp
 
 
         // ------------------------------------------------
-        // FieldParser
+        // visitField
         // ------------------------------------------------
 
-        template<typename Field> struct FieldParser;
-
+        // Visit the field corresponding to a given tag inside a Message.
         //
-        // Specialization of our parser for a simple FieldRef
-        // 
+        // The index of the field inside the Message tuple is retrieved through the
+        // TagTable of the Message. We then jump to the field through a table of thunks,
+        // one per field, which makes the cost of a lookup independent of the number of
+        // fields of the Message
 
-        template<typename TagT>
-        struct FieldParser<FieldRef<TagT>>
+        template<size_t Index, typename Message, typename Visitor>
+        void doVisitSingleField(Message& message, Visitor& visitor)
         {
-            using Field = FieldRef<TagT>;
+            visitor(meta::get<Index>(message.values));
+        }
 
-            template<typename TagSet>
-            void parse(Field& field, ParsingContext& context, TagSet& tagSet, bool /* strict */, bool /* skipUnknown */)
-            {
-                auto& cursor = context.cursor;
-                // @Todo: In Strict mode, validate the type of the Tag
-                StreamCursor::Token valueToken(context.cursor);
-                TRY_MATCH_UNTIL(SOH, "Expected value tag '%d', got EOF", TagT::Id);
+        template<typename Message, typename Visitor, size_t... Indexes>
+        void doVisitField(Message& message, size_t index, Visitor& visitor,
+                          meta::seq::index_sequence<Indexes...>)
+        {
+            using Thunk = void (*)(Message&, Visitor&);
+            static constexpr Thunk Thunks[] = {
+                &doVisitSingleField<Indexes, Message, Visitor>...
+            };
 
-                auto view = valueToken.view();
-                TRY_ADVANCE("Expected value after tag '%d', got EOF", TagT::Id);
+            Thunks[index](message, visitor);
+        }
 
-                field.set(view);
-                tagSet.set(field.tag());
-            }
-        };
+        template<typename Message, typename Visitor>
+        void doVisitField(Message&, size_t, Visitor&, meta::seq::index_sequence<>)
+        {
+        }
+
+        template<typename Message, typename Visitor>
+        bool visitField(Message& message, unsigned tag, Visitor& visitor)
+        {
+            static constexpr size_t Size = Message::TotalTags;
+            using Table = typename details::MakeTagTable<typename Message::TagsList>::Result;
+
+            const int index = Table::of(tag);
+            if (index == -1)
+                return false;
+
+            doVisitField(message, static_cast<size_t>(index), visitor, meta::seq::make_index_sequence<Size>{});
+            message.allBits.set(static_cast<size_t>(index));
+
+            return true;
+        }
 
         // ------------------------------------------------
-        // FieldGroupVisitor
+        // Source
         // ------------------------------------------------
 
+        inline bool parseInt(const View& view, int* value)
+        {
+            uint64_t integer;
+            const size_t count = swar::parseUnsigned(view.first, view.first + view.second, std::numeric_limits<int>::max(), &integer);
+            if (count == 0 || count != view.second)
+                return false;
+
+            *value = static_cast<int>(integer);
+            return true;
+        }
+
+        // The parsers below read the fields of a frame from a Source, one field at a time.
+        // The fields are either tokenized from the bytes of the frame as they are read
+        // (CursorSource) or have already been located by a FieldIndex (IndexSource, see
+        // index.h), in which case resolving them does not scan the frame again.
         //
-        // Field parsing inside a RepeatingGroup
+        // A Source provides:
+        //   - done(), whether every field of the frame has been read
+        //   - offset(), the position of the current field inside the frame
+        //   - readTag(), which reads the tag of the current field
+        //   - readValue(), which reads the value of the current field and moves to the next one
+        //   - readChecksum(), same as readValue() for the CheckSum field
+        //   - a Revert guard, which moves back to the field it has been created on unless ignored
         //
+        // Read functions set an error on the context and return false on failure
 
-        template<typename Field>
-        struct FieldGroupVisitor
+        template<typename ContextT>
+        struct CursorSource
         {
-            static constexpr bool Recursive = false;
+            using Context = ContextT;
+
+            struct Revert
+            {
+                Revert(CursorSource& source)
+                    : revert(source.context.cursor)
+                { }
+
+                void ignore()
+                {
+                    revert.ignore();
+                }
+
+            private:
+                typename Context::Revert revert;
+            };
+
+            CursorSource(Context& context)
+                : context(context)
+            { }
+
+            bool done() const
+            {
+                return context.cursor.eof();
+            }
 
-            template<typename TagSet>
-            void operator()(Field& field,
-                            ParsingContext& context, TagSet&, bool, bool)
+            const char* offset() const
+            {
+                return context.cursor.offset();
+            }
+
+            bool readTag(int* tag)
             {
-                static constexpr auto Tag = Field::Tag::Id;
                 auto& cursor = context.cursor;
 
-                StreamCursor::Token valueToken(cursor);
-                TRY_MATCH_UNTIL(SOH, "Expected value after tag %d, got EOF", Tag);
+                if (!match_int_fast(tag, cursor))
+                {
+                    context.setError(ErrorKind::ParsingError, "Encountered invalid tag, expected int, got '%c'", CURSOR_CURRENT(cursor));
+                    return false;
+                }
+
+                // Literal('=')
+                if (!cursor.advance(1))
+                {
+                    context.setError(ErrorKind::Incomplete, "Expected value after Tag %d, got EOF", *tag);
+                    return false;
+                }
 
-                auto view = valueToken.view();
+                return true;
+            }
 
-                field.set(view);
+            bool readValue(int tag, View* view)
+            {
+                auto& cursor = context.cursor;
+
+                typename Context::Token valueToken(cursor);
+                if (!match_until_fast(SOH, cursor))
+                {
+                    context.setError(ErrorKind::ParsingError, "Expected value after tag %d, got EOF", tag);
+                    return false;
+                }
+
+                *view = valueToken.view();
+
+                // Literal(SOH)
+                cursor.advance(1);
+                return true;
+            }
+
+            bool readChecksum(int* checksum)
+            {
+                auto& cursor = context.cursor;
+
+                if (!match_int_fast(checksum, cursor))
+                {
+                    context.setError(ErrorKind::ParsingError, "Invalid checksum, expected int, got '%c'", CURSOR_CURRENT(cursor));
+                    return false;
+                }
+
+                return true;
             }
+
+            Context& context;
         };
 
+        template<typename ContextT>
+        struct IndexSource
+        {
+            using Context = ContextT;
+
+            struct Revert
+            {
+                Revert(IndexSource& source)
+                    : source(source)
+                    , pos(source.pos)
+                    , active(true)
+                { }
+
+                ~Revert()
+                {
+                    if (active)
+                        source.pos = pos;
+                }
+
+                void ignore()
+                {
+                    active = false;
+                }
+
+            private:
+                IndexSource& source;
+                size_t pos;
+                bool active;
+            };
+
+            IndexSource(Context& context, const FieldIndex& index, size_t pos)
+                : context(context)
+                , index(index)
+                , pos(pos)
+            { }
+
+            bool done() const
+            {
+                return pos == index.size();
+            }
+
+            const char* offset() const
+            {
+                return index.frame() + index.fieldOffset(pos);
+            }
+
+            bool readTag(int* tag)
+            {
+                *tag = static_cast<int>(index[pos].tag);
+                return true;
+            }
+
+            bool readValue(int /* tag */, View* view)
+            {
+                *view = index.view(pos++);
+                return true;
+            }
+
+            bool readChecksum(int* checksum)
+            {
+                if (!parseInt(index.view(pos), checksum))
+                {
+                    context.setError(ErrorKind::InvalidChecksum, "Invalid CheckSum, expected int");
+                    return false;
+                }
+
+                ++pos;
+                return true;
+            }
+
+            Context& context;
+            const FieldIndex& index;
+            size_t pos;
+        };
+
+        // ------------------------------------------------
+        // FieldParser
+        // ------------------------------------------------
+
+        template<typename Field> struct FieldParser;
+
         //
-        // Recursive RepeatingGroup parsing
-        //
+        // Specialization of our parser for a simple FieldRef
+        // 
 
-        template<typename GroupTag, typename SizeHint, typename... Tags>
-        struct FieldGroupVisitor<FieldRef<SmallRepeatingGroup<GroupTag, SizeHint, Tags...>>>
+        template<typename TagT>
+        struct FieldParser<FieldRef<TagT>>
         {
-            static constexpr bool Recursive = true;
+            using Field = FieldRef<TagT>;
 
-            template<typename Field, typename TagSet>
-            void operator()(Field& field,
-                            ParsingContext& context, TagSet& outerSet, bool strict, bool skipUnknown)
+            template<typename Source, typename TagSet>
+            void parse(Field& field, Source& source, TagSet& tagSet, bool /* strict */, bool /* skipUnknown */)
             {
-                FieldParser<Field> parser;
-                parser.parse(field, context, outerSet, strict, skipUnknown);
+                // @Todo: In Strict mode, validate the type of the Tag
+                View view;
+                if (!source.readValue(TagT::Id, &view))
+                    return;
+
+                field.set(view);
+                tagSet.set(field.tag());
             }
         };
 
@@ -789,58 +1339,51 @@ namespace Fixpp
             //
             using GroupSet = TagSet<Tags...>;
 
+            // Fields of an instance, including nested RepeatingGroups, are parsed
+            // by the same parsers as the fields of the Message
+            template<typename Source>
             struct Visitor
             {
-                Visitor(ParsingContext& context, GroupSet& groupSet, bool strict, bool skipUnknown)
-                    : recursive(false)
-                    , context(context)
+                Visitor(Source& source, GroupSet& groupSet, bool strict, bool skipUnknown)
+                    : source(source)
                     , groupSet(groupSet)
                     , strict(strict)
                     , skipUnknown(skipUnknown)
-                    
                 { }
 
                 template<typename Field>
                 void operator()(Field& field)
                 {
-                    using GroupVisitor = FieldGroupVisitor<Field>;
-
-                    GroupVisitor visitor;
-                    visitor(field, context, groupSet, strict, skipUnknown);
-
-                    recursive = GroupVisitor::Recursive;
+                    FieldParser<Field> parser;
+                    parser.parse(field, source, groupSet, strict, skipUnknown);
                 }
 
-                // Indicates whether we are in a recursive RepeatingGroup or not
-                bool recursive;
-
             private:
-                ParsingContext& context;
+                Source& source;
                 GroupSet& groupSet;
                 bool strict;
                 bool skipUnknown;
             };
 
-            template<typename TagSet>
-            void parse(Field& field, ParsingContext& context, TagSet& tagSet, bool strict, bool skipUnknown)
+            template<typename Source, typename TagSet>
+            void parse(Field& field, Source& source, TagSet& tagSet, bool strict, bool skipUnknown)
             {
-                auto& cursor = context.cursor;
+                auto& context = source.context;
 
-                int instances;
-                TRY_MATCH_INT(
-                    instances,
-                    "Could not parse instances number in RepeatingGroup %d, expected int, got '%c'",
-                     GroupTag::Id, CURSOR_CURRENT(cursor)
-                );
+                View count;
+                if (!source.readValue(GroupTag::Id, &count))
+                    return;
 
-                if (!instances)
+                int instances;
+                if (!parseInt(count, &instances))
                 {
-                    TRY_ADVANCE("Got early EOF after tag %d value", GroupTag::Id);
+                    context.setTagError(ErrorKind::ParsingError, GroupTag::Id, count,
+                            "Could not parse instances number in RepeatingGroup %d, expected int", GroupTag::Id);
                     return;
                 }
 
-                // Literal('=')
-                TRY_ADVANCE("Expected RepeatingGroup %d, got EOF", GroupTag::Id);
+                if (!instances)
+                    return;
 
                 field.reserve(instances);
 
@@ -853,41 +1396,36 @@ namespace Fixpp
                 {
                     typename Field::GroupType groupRef;
 
-                    for (;;)
+                    while (!source.done())
                     {
+                        typename Source::Revert revertTag(source);
+                        if (!source.readTag(&tag))
+                            return;
 
-                        StreamCursor::Revert revertTag(cursor);
-                        TRY_MATCH_INT(
-                            tag,
-                            "Could not parse tag in RepeatingGroup %d, expected int, got '%c'",
-                            GroupTag::Id, CURSOR_CURRENT(cursor)
-                        );
+                        const int slot = GroupSet::index(tag);
 
                         // The tag we just encountered is invalid for the RepeatingGroup
-                        if (!groupSet.valid(tag))
+                        if (slot == -1)
                         {
                             // If it's not valid for the Message either, we consider it to be
                             // a custom tag
                             if (!tagSet.valid(tag) && tag != 10)
                             {
                                 revertTag.ignore();
-                                TRY_ADVANCE("Expected value after tag %d, got EOF", tag);
 
-                                StreamCursor::Token valueToken(cursor);
-                                TRY_MATCH_UNTIL(SOH, "Expected value after tag %d, got EOF", tag);
+                                View view;
+                                if (!source.readValue(tag, &view))
+                                    return;
 
-                                if (!strict)
-                                {
-                                    if (!skipUnknown)
-                                        groupRef.unparsed.emplace_back(tag, valueToken.view());
-                                    TRY_ADVANCE("Got early EOF after tag %d value", tag);
-                                    continue;
-                                }
-                                else if (strict)
+                                if (strict)
                                 {
-                                    context.setError(ErrorKind::UnknownTag, "Encountered unknown tag %d in RepeatingGroup %d", tag, GroupTag::Id);
+                                    context.setTagError(ErrorKind::UnknownTag, tag, view, "Encountered unknown tag %d in RepeatingGroup %d", tag, GroupTag::Id);
                                     return;
                                 }
+
+                                if (!skipUnknown)
+                                    groupRef.unparsed.emplace_back(tag, view);
+                                continue;
                             }
 
                             inGroup = false;
@@ -895,17 +1433,14 @@ namespace Fixpp
                         }
 
                         // The tag is already set in our GroupSet, we finished parsing the current instance
-                        if (groupSet.test(tag))
+                        if (groupSet.testAt(static_cast<size_t>(slot)))
                             break;
 
                         revertTag.ignore();
 
-                        // Literal('=')
-                        TRY_ADVANCE("Expected value after Tag %d, got EOF", tag);
-
-                        groupSet.set(tag);
+                        groupSet.setAt(static_cast<size_t>(slot));
 
-                        Visitor visitor(context, groupSet, strict, skipUnknown);
+                        Visitor<Source> visitor(source, groupSet, strict, skipUnknown);
 
                         // Invariant: here visitField should ALWAYS return true as we are checking if the tag
                         // is valid prior to the call
@@ -913,11 +1448,13 @@ namespace Fixpp
                         // TODO: enfore the invariant ?
                         visitField(groupRef, tag, visitor);
 
-                        // If we are in a recursive RepeatingGroup parsing, we must *NOT* advance the cursor
-                        if (!visitor.recursive)
-                            TRY_ADVANCE("Got early EOF in RepeatingGroup %d", GroupTag::Id);
+                        if (context.hasError())
+                            return;
                     }
 
+                    if (source.done())
+                        inGroup = false;
+
                     field.add(std::move(groupRef));
                     groupSet.reset();
 
@@ -930,11 +1467,11 @@ namespace Fixpp
         // FieldVisitor
         // ------------------------------------------------
 
-        template<typename Message>
+        template<typename Message, typename Source>
         struct FieldVisitor
         {
-            FieldVisitor(ParsingContext& context, bool strict, bool skipUnknown)
-                : context(context)
+            FieldVisitor(Source& source, bool strict, bool skipUnknown)
+                : source(source)
                 , strict(strict)
                 , skipUnknown(skipUnknown)
             { }
@@ -945,279 +1482,1085 @@ namespace Fixpp
                 TagSet<Message> tags;
 
                 FieldParser<Field> parser;
-                parser.parse(field, context, tags, strict, skipUnknown);
+                parser.parse(field, source, tags, strict, skipUnknown);
             }
 
         private:
-            ParsingContext& context;
+            Source& source;
             bool strict;
             bool skipUnknown;
         };
 
         // ------------------------------------------------
-        // MessageVisitor
+        // Framing
         // ------------------------------------------------
 
-        template<typename Visitor, typename Rules>
-        struct MessageVisitor
+        // The CheckSum is the sum of every byte of the frame, from BeginString
+        // up to the CheckSum tag itself, modulo 256
+        template<typename Context>
+        void validateChecksum(Context& context, const char* checksumOffset, int checksum)
         {
-
-            using ResultType = typename Visitor::ResultType;
-            using Context = TypedParsingContext<ResultType>;
-
-            template<bool ...Bools> using BoolPack = meta::pack::ValuePack<bool, Bools...>;
-
-            MessageVisitor(Context& context, Visitor& visitor)
-                : context(context)
-                , visitor(visitor)
-            { }
-
-            template<typename Message, typename Header>
-            void operator()(id<Header>, id<Message>)
+            if (checksumOffset == nullptr)
             {
-                Header header;
-                Message message;
-
-                enum class State {
-                    InHeader,
-                    InMessage
-                };
-
-                State state = State::InHeader;
-
-                int checksum = 0;
+                context.setError(ErrorKind::InvalidChecksum, "Missing CheckSum");
+                return;
+            }
 
-                auto& cursor = context.cursor;
+            const auto sum = simd::sum(context.cursor.offset(0), checksumOffset) % 256;
+            if (static_cast<int>(sum) != checksum)
+                context.setError(ErrorKind::InvalidChecksum, "Invalid CheckSum, expected %03u, got %03d", sum, checksum);
+        }
 
-                while (!cursor.eof() && !hasError())
-                {
-                    int tag;
+        // Looks for the CheckSum field at the end of [first, last), returns nullptr if the
+        // frame does not end with a CheckSum field
+        inline const char* findTrailer(const char* first, const char* last)
+        {
+            // 10=N is the shortest trailer and 10=NNN<SOH> the longest one
+            static constexpr ptrdiff_t MinTrailerSize = 4;
+            static constexpr ptrdiff_t MaxTrailerSize = 7;
 
-                    TRY_MATCH_INT(
-                        tag,
-                        "Encountered invalid tag, expected int, got '%c'",
-                        CURSOR_CURRENT(cursor)
-                    );
-                    TRY_ADVANCE("Expected value after Tag %d, got EOF", tag);
+            for (const char* trailer = last - MinTrailerSize; trailer > first && last - trailer <= MaxTrailerSize; --trailer)
+            {
+                if (trailer[-1] == SOH && trailer[0] == '1' && trailer[1] == '0' && trailer[2] == '=')
+                    return trailer;
+            }
 
-                    if (state == State::InHeader)
-                    {
-                        FieldVisitor<Header> headerVisitor(context, Rules::StrictMode, Rules::SkipUnknownTags);
-                        if (visitField(header, tag, headerVisitor))
-                            continue;
+            return nullptr;
+        }
 
-                        FieldVisitor<Message> messageVisitor(context, Rules::StrictMode, Rules::SkipUnknownTags);
-                        if (visitField(message, tag, messageVisitor))
-                        {
-                            state = State::InMessage;
-                            continue;
-                        }
-                    }
-                    else if (state == State::InMessage)
-                    {
-                        FieldVisitor<Message> messageVisitor(context, Rules::StrictMode, Rules::SkipUnknownTags);
-                        if (visitField(message, tag, messageVisitor))
-                            continue;
-                    }
+        template<typename Context>
+        void validateTrailer(Context& context, const char* trailer, const char* end, std::true_type /* ValidateChecksum */)
+        {
+            RawCursor cursor(trailer + 3, end);
 
-                    if (tag == 10)
-                    {
-                        TRY_MATCH_INT(
-                            checksum,
-                            "Invalid checksum, expected int, got '%c'",
-                             CURSOR_CURRENT(cursor)
-                        );
-                        break;
-                    }
-                    else
-                    {
-                        StreamCursor::Token valueToken(cursor);
-                        TRY_MATCH_UNTIL(SOH, "Expected value after tag %d, got EOF", tag);
+            int checksum;
+            if (!match_int_fast(&checksum, cursor) || (!cursor.eof() && cursor.current() != SOH))
+            {
+                context.setError(ErrorKind::InvalidChecksum, "Invalid CheckSum, expected int");
+                return;
+            }
 
-                        if (state == State::InHeader)
-                            handleUnknownTag(valueToken, header, context, tag,
-                                    BoolPack<Rules::SkipUnknownTags, Rules::StrictMode>{});
-                        else
-                            handleUnknownTag(valueToken, message, context, tag,
-                                    BoolPack<Rules::SkipUnknownTags, Rules::StrictMode>{});
+            validateChecksum(context, trailer, checksum);
+        }
 
-                    }
+        template<typename Context>
+        void validateTrailer(Context& /*context*/, const char* /*trailer*/, const char* /*end*/, std::false_type /* ValidateChecksum */)
+        {
+        }
 
-                    TRY_ADVANCE("Got early EOF");
+        // The BodyLength is the number of bytes between the BodyLength field and the
+        // CheckSum field. It gives the position of the CheckSum field without having
+        // to tokenize the body, which means that truncated or over-long frames are
+        // rejected in O(1), before parsing any field
+        template<typename Rules, typename Context>
+        void validateLength(Context& context, int bodyLength, std::true_type /* ValidateLength */)
+        {
+            // The shortest trailer is 10=N and the longest one 10=NNN<SOH>
+            static constexpr size_t MinTrailerSize = 4;
+            static constexpr size_t MaxTrailerSize = 7;
 
-                }
+            auto& cursor = context.cursor;
 
-                if (!hasError())
-                    callVisitor(header, message, std::is_void<typename Context::Type>{});
-            }
+            const auto remaining = cursor.remaining();
+            const auto length = static_cast<size_t>(bodyLength);
 
-            bool hasError() const
+            if (bodyLength <= 0)
             {
-                return context.hasError();
+                context.setError(ErrorKind::InvalidLength, "Invalid BodyLength(%d)", bodyLength);
+                return;
             }
 
-        private:
-
-            // not(SkipUnknownTags) and not(StrictMode)
-            template<typename Message, typename Context>
-            void handleUnknownTag(const StreamCursor::Token& valueToken, Message& message, Context& /*context*/, int tag,
-                                  BoolPack<false, false>)
+            if (remaining < length + MinTrailerSize)
             {
-                message.unparsed.emplace_back(tag, valueToken.view());
+                context.setError(ErrorKind::InvalidLength, "Truncated frame, BodyLength(%d) goes past the end of the frame", bodyLength);
+                return;
             }
 
-            // SkipUnknownTags and StrictMode, SkipUnknownTags wins ?
-            template<typename Message, typename Context>
-            void handleUnknownTag(const StreamCursor::Token& /*valueToken*/, Message& /*message*/, Context& /*context*/, int /*tag*/,
-                                  BoolPack<true, true>)
+            if (remaining > length + MaxTrailerSize)
             {
+                context.setError(ErrorKind::InvalidLength, "Frame is longer than BodyLength(%d)", bodyLength);
+                return;
             }
 
-            // SkipUnknownTags and not(StrictMode)
-            template<typename Message, typename Context>
-            void handleUnknownTag(const StreamCursor::Token& /*valueToken*/, Message& /*message*/, Context& /*context*/, int /*tag*/,
-                                  BoolPack<true, false>)
+            const char* trailer = cursor.offset() + length;
+            if (trailer[-1] != SOH || std::memcmp(trailer, "10=", 3) != 0)
             {
+                context.setError(ErrorKind::InvalidLength, "BodyLength(%d) does not end on the CheckSum field", bodyLength);
+                return;
             }
 
-            // not(SkipUnknownTags) and StrictMode
-            template<typename Message, typename Context>
-            void handleUnknownTag(const StreamCursor::Token& /*valueToken*/, Message& /*message*/, Context& context, int tag,
-                                  BoolPack<false, true>)
-            {
-                context.setError(ErrorKind::UnknownTag, "Encountered unknown tag %d", tag);
-            }
+            context.setTrailer(trailer);
+            validateTrailer(context, trailer, cursor.offset() + remaining, std::integral_constant<bool, Rules::ValidateChecksum>{});
+        }
 
-            template<typename Header, typename Message>
-            void callVisitor(const Header& header, const Message& message, std::true_type /* is_void */)
-            {
-                visitor(header, message);
-            }
+        template<typename Rules, typename Context>
+        void validateLength(Context& /*context*/, int /*bodyLength*/, std::false_type /* ValidateLength */)
+        {
+        }
 
-            template<typename Header, typename Message>
-            void callVisitor(const Header& header, const Message& message, std::false_type /* is_void */)
-            {
+        // ------------------------------------------------
+        // reuse
+        // ------------------------------------------------
+
+        // Header and Message Refs are large: a tuple of FieldRefs, two bitsets and the
+        // inline storage of unparsed fields. When the ReuseMessages rule is on, every thread
+        // keeps one Ref per type, which is reset once the frame has been visited. Resetting a
+        // Ref only clears its bitsets, its unparsed fields and the RepeatingGroups that have
+        // been set: fields themselves are never zeroed as they are only read through allBits.
+        // RepeatingGroups also keep their heap storage from one frame to another.
+
+        namespace reuse
+        {
+
+            template<typename Field>
+            struct FieldReset
+            {
+                static void reset(Field&)
+                {
+                }
+            };
+
+            template<typename GroupTag, typename SizeHint, typename... Tags>
+            struct FieldReset<FieldRef<SmallRepeatingGroup<GroupTag, SizeHint, Tags...>>>
+            {
+                template<typename Field>
+                static void reset(Field& field)
+                {
+                    field.clear();
+                }
+            };
+
+            template<size_t Index, typename Message>
+            void resetField(Message& message)
+            {
+                using Field = typename std::decay<decltype(meta::get<Index>(message.values))>::type;
+
+                if (message.allBits.test(Index))
+                    FieldReset<Field>::reset(meta::get<Index>(message.values));
+            }
+
+            template<typename Message, size_t... Indexes>
+            void resetFields(Message& message, meta::seq::index_sequence<Indexes...>)
+            {
+                int dummy[] = { 0, ((void) resetField<Indexes>(message), 0)... };
+                (void) dummy;
+            }
+
+            template<typename Message>
+            void reset(Message& message)
+            {
+                resetFields(message, meta::seq::make_index_sequence<Message::TotalTags>{});
+
+                message.allBits.reset();
+                message.requiredBits.reset();
+                message.unparsed.clear();
+            }
+
+            template<typename Ref>
+            struct Slot
+            {
+                Ref ref;
+                bool busy = false;
+            };
+
+            // A Ref constructed for a single frame, the default
+            template<typename Ref>
+            struct Local
+            {
+                Ref& get()
+                {
+                    return ref;
+                }
+
+            private:
+                Ref ref;
+            };
+
+            // Borrows the Ref cached by the calling thread. If the cached Ref is already
+            // borrowed, because the Visitor is itself visiting another frame, a fresh
+            // Ref is constructed instead
+            template<typename Ref>
+            struct Lease
+            {
+                Lease()
+                    : slot(cached())
+                    , owner(!slot.busy)
+                {
+                    if (owner)
+                        slot.busy = true;
+                    else
+                        fresh.emplace();
+                }
+
+                // The Ref is reset as soon as the frame has been visited, while the
+                // storage it might hold from an Arena is still alive
+                ~Lease()
+                {
+                    if (owner)
+                    {
+                        reset(slot.ref);
+                        slot.busy = false;
+                    }
+                }
+
+                Lease(const Lease&) = delete;
+                Lease& operator=(const Lease&) = delete;
+
+                Ref& get()
+                {
+                    return owner ? slot.ref : *fresh;
+                }
+
+            private:
+                static Slot<Ref>& cached()
+                {
+                    static thread_local Slot<Ref> slot;
+                    return slot;
+                }
+
+                Slot<Ref>& slot;
+                bool owner;
+                std::optional<Ref> fresh;
+            };
+
+            template<typename Rules, typename Ref>
+            using Storage = typename std::conditional<
+                rules::ReuseMessages<Rules>::value, Lease<Ref>, Local<Ref>
+            >::type;
+
+        } // namespace reuse
+
+        // ------------------------------------------------
+        // MessageVisitor
+        // ------------------------------------------------
+
+        template<typename Visitor, typename Rules, typename SourceT>
+        struct MessageVisitor
+        {
+
+            using ResultType = typename Visitor::ResultType;
+            using Source = SourceT;
+            using Context = typename Source::Context;
+
+            template<bool ...Bools> using BoolPack = meta::pack::ValuePack<bool, Bools...>;
+
+            MessageVisitor(Source& source, Visitor& visitor)
+                : source(source)
+                , context(source.context)
+                , visitor(visitor)
+            { }
+
+            template<typename Message, typename Header>
+            void operator()(id<Header> header, id<Message> message)
+            {
+                // StrictMode asks for every field to be validated, even for unhandled messages
+                static constexpr bool Parse = HandlesMessage<Visitor, Header, Message>::value
+                                           || !rules::SkipUnhandledMessages<Rules>::value
+                                           || Rules::StrictMode;
+
+                visitMessage(header, message, std::integral_constant<bool, Parse>{});
+            }
+
+            bool hasError() const
+            {
+                return context.hasError();
+            }
+
+        private:
+
+            // The Visitor only handles the Message through its catch-all overload and the rules
+            // skip such messages: the body is neither tokenized nor validated against the
+            // Dictionary and the catch-all gets an empty Header and Message. Only the CheckSum
+            // and BodyLength are checked, if asked for
+            template<typename Message, typename Header>
+            void visitMessage(id<Header>, id<Message>, std::false_type /* Parse */)
+            {
+                // When the frame has been framed through its BodyLength, the CheckSum
+                // has already been validated
+                if (context.trailer == nullptr)
+                    validateTrailer(std::integral_constant<bool, Rules::ValidateChecksum>{});
+
+                if (!hasError())
+                    callVisitor(Header { }, Message { }, std::is_void<typename Context::Type>{});
+            }
+
+            template<typename Message, typename Header>
+            void visitMessage(id<Header> header, id<Message> message, std::true_type /* Parse */)
+            {
+                parseMessage(header, message, projection::ProjectionFor<Visitor, Rules>{});
+            }
+
+            template<typename Message, typename Header>
+            void parseMessage(id<Header>, id<Message>, projection::None)
+            {
+                reuse::Storage<Rules, Header> headerStorage;
+                reuse::Storage<Rules, Message> messageStorage;
+
+                auto& header = headerStorage.get();
+                auto& message = messageStorage.get();
+
+                enum class State {
+                    InHeader,
+                    InMessage
+                };
+
+                State state = State::InHeader;
+
+                int checksum = -1;
+                const char* checksumOffset = nullptr;
+
+                while (!source.done() && !hasError())
+                {
+                    int tag;
+                    const char* tagOffset = source.offset();
+
+                    if (!source.readTag(&tag))
+                        return;
+
+                    if (state == State::InHeader)
+                    {
+                        FieldVisitor<Header, Source> headerVisitor(source, Rules::StrictMode, Rules::SkipUnknownTags);
+                        if (visitField(header, tag, headerVisitor))
+                            continue;
+
+                        FieldVisitor<Message, Source> messageVisitor(source, Rules::StrictMode, Rules::SkipUnknownTags);
+                        if (visitField(message, tag, messageVisitor))
+                        {
+                            state = State::InMessage;
+                            continue;
+                        }
+                    }
+                    else if (state == State::InMessage)
+                    {
+                        FieldVisitor<Message, Source> messageVisitor(source, Rules::StrictMode, Rules::SkipUnknownTags);
+                        if (visitField(message, tag, messageVisitor))
+                            continue;
+                    }
+
+                    if (tag == 10)
+                    {
+                        checksumOffset = tagOffset;
+                        if (!source.readChecksum(&checksum))
+                            return;
+                        break;
+                    }
+
+                    View view;
+                    if (!source.readValue(tag, &view))
+                        return;
+
+                    if (state == State::InHeader)
+                        handleUnknownTag(view, header, tag,
+                                BoolPack<Rules::SkipUnknownTags, Rules::StrictMode>{});
+                    else
+                        handleUnknownTag(view, message, tag,
+                                BoolPack<Rules::SkipUnknownTags, Rules::StrictMode>{});
+                }
+
+                if (!hasError() && context.trailer != nullptr && checksumOffset != context.trailer)
+                    context.setError(ErrorKind::InvalidLength, "CheckSum does not match BodyLength(%d)", context.bodyLength);
+
+                // When the frame has been framed through its BodyLength, the CheckSum
+                // has already been validated before parsing the body
+                if (!hasError() && context.trailer == nullptr)
+                    validateChecksum(checksumOffset, checksum, std::integral_constant<bool, Rules::ValidateChecksum>{});
+
+                if (!hasError())
+                    callVisitor(header, message, std::is_void<typename Context::Type>{});
+            }
+
+            // Only the projected fields are parsed, every other field is skipped
+            // without being stored. Unknown tags are skipped as well
+            template<typename Message, typename Header, typename... Tags>
+            void parseMessage(id<Header>, id<Message>, Projection<Tags...>)
+            {
+                using Traits = projection::Traits<Projection<Tags...>>;
+                using Table = typename Traits::Table;
+
+                static_assert(!Rules::StrictMode, "A Projection can not be used in StrictMode");
+
+                reuse::Storage<Rules, Header> headerStorage;
+                reuse::Storage<Rules, Message> messageStorage;
+
+                auto& header = headerStorage.get();
+                auto& message = messageStorage.get();
+
+                std::bitset<Traits::Size> seen;
+                size_t stops = Traits::StopCount;
+
+                int checksum = -1;
+                const char* checksumOffset = nullptr;
+
+                while (!source.done() && !hasError())
+                {
+                    int tag;
+                    const char* tagOffset = source.offset();
+
+                    if (!source.readTag(&tag))
+                        return;
+
+                    if (tag == 10)
+                    {
+                        checksumOffset = tagOffset;
+                        if (!source.readChecksum(&checksum))
+                            return;
+                        break;
+                    }
+
+                    const int index = Table::of(static_cast<unsigned>(tag));
+                    if (index != -1)
+                    {
+                        FieldVisitor<Header, Source> headerVisitor(source, false, Rules::SkipUnknownTags);
+                        FieldVisitor<Message, Source> messageVisitor(source, false, Rules::SkipUnknownTags);
+
+                        if (visitField(header, tag, headerVisitor) || visitField(message, tag, messageVisitor))
+                        {
+                            if (Traits::stops(index) && !seen.test(index))
+                            {
+                                seen.set(index);
+                                if (--stops == 0)
+                                    break;
+                            }
+
+                            continue;
+                        }
+                    }
+
+                    View view;
+                    if (!source.readValue(tag, &view))
+                        return;
+                }
+
+                if (hasError())
+                    return;
+
+                // Parsing stopped before reaching the CheckSum
+                if (Traits::StopCount > 0 && stops == 0)
+                {
+                    if (context.trailer == nullptr)
+                        validateTrailer(std::integral_constant<bool, Rules::ValidateChecksum>{});
+                }
+                else if (context.trailer != nullptr)
+                {
+                    if (checksumOffset != context.trailer)
+                        context.setError(ErrorKind::InvalidLength, "CheckSum does not match BodyLength(%d)", context.bodyLength);
+                }
+                else
+                {
+                    validateChecksum(checksumOffset, checksum, std::integral_constant<bool, Rules::ValidateChecksum>{});
+                }
+
+                if (!hasError())
+                    callVisitor(header, message, std::is_void<typename Context::Type>{});
+            }
+
+            // not(SkipUnknownTags) and not(StrictMode)
+            template<typename Message>
+            void handleUnknownTag(const View& view, Message& message, int tag,
+                                  BoolPack<false, false>)
+            {
+                message.unparsed.emplace_back(tag, view);
+            }
+
+            // SkipUnknownTags and StrictMode, SkipUnknownTags wins ?
+            template<typename Message>
+            void handleUnknownTag(const View& /*view*/, Message& /*message*/, int /*tag*/,
+                                  BoolPack<true, true>)
+            {
+            }
+
+            // SkipUnknownTags and not(StrictMode)
+            template<typename Message>
+            void handleUnknownTag(const View& /*view*/, Message& /*message*/, int /*tag*/,
+                                  BoolPack<true, false>)
+            {
+            }
+
+            // not(SkipUnknownTags) and StrictMode
+            template<typename Message>
+            void handleUnknownTag(const View& view, Message& /*message*/, int tag,
+                                  BoolPack<false, true>)
+            {
+                context.setTagError(ErrorKind::UnknownTag, tag, view, "Encountered unknown tag %d", tag);
+            }
+
+            void validateChecksum(const char* checksumOffset, int checksum, std::true_type /* ValidateChecksum */)
+            {
+                impl::validateChecksum(context, checksumOffset, checksum);
+            }
+
+            void validateChecksum(const char* /*checksumOffset*/, int /*checksum*/, std::false_type /* ValidateChecksum */)
+            {
+            }
+
+            // Locates the CheckSum field from the end of the frame, without tokenizing the body
+            void validateTrailer(std::true_type /* ValidateChecksum */)
+            {
+                auto& cursor = context.cursor;
+
+                const char* first = cursor.offset(0);
+                const char* last = cursor.offset() + cursor.remaining();
+
+                const char* trailer = findTrailer(first, last);
+                if (trailer == nullptr)
+                {
+                    context.setError(ErrorKind::InvalidChecksum, "Missing CheckSum");
+                    return;
+                }
+
+                impl::validateTrailer(context, trailer, last, std::true_type{});
+            }
+
+            void validateTrailer(std::false_type /* ValidateChecksum */)
+            {
+            }
+
+            // Containers grown by the visitor itself might outlive the frame: they must not
+            // draw from the Arena of the visit, which is only meant for the parsing
+
+            template<typename Header, typename Message>
+            void callVisitor(const Header& header, const Message& message, std::true_type /* is_void */)
+            {
+                Fixpp::details::arena::Scope scope(nullptr);
+                visitor(header, message);
+            }
+
+            template<typename Header, typename Message>
+            void callVisitor(const Header& header, const Message& message, std::false_type /* is_void */)
+            {
+                Fixpp::details::arena::Scope scope(nullptr);
                 auto res = visitor(header, message);
                 context.setValue(res);
             }
 
+            Source& source;
             Context& context;
             Visitor& visitor;
         };
 
-    } // namespace impl
+        // ------------------------------------------------
+        // Indexed parsing
+        // ------------------------------------------------
+
+        // Second stage of the two-stage parser: the fields of a frame have already been
+        // located by a FieldIndex (see index.h). The entries of the index are resolved
+        // into the fields of the Header and Message by the MessageVisitor above, through
+        // an IndexSource
+
+        namespace indexed
+        {
+
+            template<typename Visitor, typename Rules, typename Context>
+            void visitMessage(Context& context, const FieldIndex& index, Visitor& visitor, Rules rules)
+            {
+                if (index.size() < 3
+                        || index[0].tag != Tag::BeginString::Id
+                        || index[1].tag != Tag::BodyLength::Id
+                        || index[2].tag != Tag::MsgType::Id)
+                {
+                    context.setError(ErrorKind::ParsingError, "Expected BeginString, BodyLength and MsgType at the beginning of the frame");
+                    return;
+                }
+
+                int bodyLength;
+                if (!parseInt(index.view(1), &bodyLength))
+                {
+                    context.setError(ErrorKind::ParsingError, "Could not parse BodyLength, expected int");
+                    return;
+                }
+
+                context.setVersion(index.view(0));
+                context.setBodyLength(bodyLength);
+                context.setMsgType(index.view(2));
+
+                context.cursor.advance(index.fieldOffset(2));
+                impl::validateLength<Rules>(context, bodyLength, std::integral_constant<bool, Rules::ValidateLength>{});
+                if (context.hasError())
+                    return;
+
+                // Skip BeginString, BodyLength and MsgType
+                IndexSource<Context> source(context, index, 3);
+
+                MessageVisitor<Visitor, Rules, IndexSource<Context>> messageVisitor(source, visitor);
+                impl::visitMessage(context, messageVisitor, rules);
+            }
+
+        } // namespace indexed
+
+    } // namespace impl
+
+    struct VisitRules
+    {
+        template<typename... Args>
+        using OverrideSet = meta::map::Map<Args...>;
+
+        template<typename First, typename Second>
+        using Override = meta::map::Pair<First, Second>;
+
+        template<typename T> using As = T;
+    };
+
+
+    template<typename T>
+    struct StaticVisitor
+    {
+        using ResultType = T;
+    };
+
+    template<typename Visitor, typename Rules, typename Context>
+    void visitMessage(Context& context, Visitor& visitor, Rules rules)
+    {
+        auto& cursor = context.cursor;
+        auto beginString = impl::matchTag<Tag::BeginString>(cursor);
+
+        TRY_ADVANCE("Expected BodyLength after BeginString, got EOFs");
+
+        auto bodyLength = impl::matchTag<Tag::BodyLength>(cursor);
+        if (!bodyLength.first)
+        {
+            context.setError(ErrorKind::ParsingError,
+                             "Could not parse BodyLength, expected int, got '%c'",
+                              CURSOR_CURRENT(cursor));
+            return;
+        }
+
+        TRY_ADVANCE("Expected MsgType after BodyLength, got EOF");
+
+        context.setBodyLength(bodyLength.second);
+        impl::validateLength<Rules>(context, bodyLength.second, std::integral_constant<bool, Rules::ValidateLength>{});
+        if (context.hasError())
+            return;
+
+        auto msgType = impl::matchTag<Tag::MsgType>(cursor);
+        TRY_ADVANCE("Expected Header after MsgType, got EOF");
+
+        context.setVersion(beginString.second);
+        context.setMsgType(msgType.second);
+
+        impl::CursorSource<Context> source(context);
+
+        impl::MessageVisitor<Visitor, Rules, impl::CursorSource<Context>> messageVisitor(source, visitor);
+        impl::visitMessage(context, messageVisitor, rules);
+    }
+
+    template<typename Rules>
+    static void checkRules()
+    {
+        static_assert(std::is_base_of<VisitRules, Rules>::value, "Visit rules must inherit from VisitRules");
+
+        static_assert(
+            meta::is_detected<impl::rules::HasOverrides, Rules>::value,
+            "Visit rules must provide an Overrides typedef"
+        );
+        static_assert(
+            meta::is_detected<impl::rules::HasDictionary, Rules>::value,
+            "Visit rules must provide a Dictionary typedef"
+        );
+        static_assert(
+            meta::is_detected<impl::rules::HasValidateChecksum, Rules>::value,
+            "Visit rules must provide a static ValidateChecksum boolean"
+        );
+        static_assert(
+            meta::is_detected<impl::rules::HasValidateLength, Rules>::value,
+            "Visit rules must provide a static ValidateLength boolean"
+        );
+        static_assert(
+            meta::is_detected<impl::rules::HasStrictMode, Rules>::value,
+            "Visit rules must provide a static StrictMode boolean"
+        );
+        static_assert(
+            meta::is_detected<impl::rules::HasSkipUnknownTags, Rules>::value,
+            "Visit rules must provide a static SkipUnknownTags boolean"
+        );
+
+        impl::rules::OverridesValidator<typename Rules::Overrides> validator {};
+        (void)validator;
+    }
+
+
+    // Note that the Visitor is passed by lvalue-reference, which means that is currently
+    // not possible to pass an rvalue like a lambda or a bind-expression as a Visitor.
+    // @Investigate a way to make it possible as it will be useful with polymorphic lambdas
+
+    template<typename Visitor, typename Rules>
+    auto visit(const char* frame, size_t size, Visitor& visitor, Rules rules) -> VisitError<typename Visitor::ResultType>
+    {
+        static_assert(
+            meta::is_detected<impl::rules::HasResultType, Visitor>::value,
+            "Visitor must fulfill StaticVisitor requirement and must expose an inner ResultType type"
+        );
+        checkRules<Rules>();
+
+        RawCursor cursor(frame, size);
+
+        using ResultType = typename Visitor::ResultType;
+
+        TypedParsingContext<ResultType> context(cursor);
+        context.setLeanErrors(impl::rules::LeanErrors<Rules>::value);
+        visitMessage(context, visitor, rules);
+
+        return context.toVisitError();
+    }
+
+    // Visits a frame, drawing every allocation made by the parsing from an Arena.
+    // The Arena is reset before the frame is visited, which means that the Header
+    // and the Message handed to the visitor must not be kept past the next visit
+
+    template<typename Visitor, typename Rules>
+    auto visit(const char* frame, size_t size, Visitor& visitor, Rules rules, Arena& arena) -> VisitError<typename Visitor::ResultType>
+    {
+        arena.reset();
+        details::arena::Scope scope(arena.resource());
+
+        return visit(frame, size, visitor, rules);
+    }
+
+    // ------------------------------------------------
+    // visitBatch
+    // ------------------------------------------------
+
+    // Status of a frame visited through visitBatch(), mirrors ErrorKind::Type
+
+    enum class FrameStatus : uint8_t
+    {
+        Ok, Incomplete, ParsingError, UnknownTag, UnknownMessage,
+        InvalidVersion, InvalidTag, InvalidChecksum, InvalidLength
+    };
+
+    // Every ErrorKind::Type is listed: the compiler warns about a Type that is not mapped
+    inline FrameStatus toFrameStatus(ErrorKind::Type type)
+    {
+        switch (type)
+        {
+        case ErrorKind::Incomplete:
+            return FrameStatus::Incomplete;
+        case ErrorKind::ParsingError:
+            return FrameStatus::ParsingError;
+        case ErrorKind::UnknownTag:
+            return FrameStatus::UnknownTag;
+        case ErrorKind::UnknownMessage:
+            return FrameStatus::UnknownMessage;
+        case ErrorKind::InvalidVersion:
+            return FrameStatus::InvalidVersion;
+        case ErrorKind::InvalidTag:
+            return FrameStatus::InvalidTag;
+        case ErrorKind::InvalidChecksum:
+            return FrameStatus::InvalidChecksum;
+        case ErrorKind::InvalidLength:
+            return FrameStatus::InvalidLength;
+        }
+
+        return FrameStatus::ParsingError;
+    }
+
+    // Visits a span of frames with the same visitor. The cursor and the parsing context
+    // are shared by all frames and the next frame is prefetched while the current one
+    // is being parsed. The status of every frame is written to statuses and the number
+    // of frames that have been successfully visited is returned.
+    // Note that the value returned by the visitor, if any, is discarded
+
+    template<typename Visitor, typename Rules>
+    size_t visitBatch(const View* frames, size_t count, Visitor& visitor, Rules rules, FrameStatus* statuses)
+    {
+        static_assert(
+            meta::is_detected<impl::rules::HasResultType, Visitor>::value,
+            "Visitor must fulfill StaticVisitor requirement and must expose an inner ResultType type"
+        );
+        checkRules<Rules>();
+
+        RawCursor cursor(nullptr, static_cast<size_t>(0));
+        TypedParsingContext<void> context(cursor);
+
+        // Only the type of the errors is reported, their message is never needed
+        context.setLeanErrors(true);
+
+        size_t visited = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i + 1 < count)
+                simd::prefetch(frames[i + 1].first, frames[i + 1].second);
+
+            cursor.reset(frames[i].first, frames[i].second);
+            context.reset();
+
+            visitMessage(context, visitor, rules);
+
+            if (context.hasError())
+            {
+                statuses[i] = toFrameStatus(context.error.get().type());
+            }
+            else
+            {
+                statuses[i] = FrameStatus::Ok;
+                ++visited;
+            }
+        }
+
+        return visited;
+    }
+
+    template<typename Visitor, typename Rules>
+    std::vector<FrameStatus> visitBatch(const View* frames, size_t count, Visitor& visitor, Rules rules)
+    {
+        std::vector<FrameStatus> statuses(count);
+        visitBatch(frames, count, visitor, rules, statuses.data());
+
+        return statuses;
+    }
+
+    // ------------------------------------------------
+    // visitIndex
+    // ------------------------------------------------
+
+    // Visits a frame that has already been indexed by a FieldIndex. Entries of the
+    // index are resolved into the fields of the Header and the Message without
+    // scanning the frame again
+
+    template<typename Visitor, typename Rules>
+    auto visitIndex(const FieldIndex& index, Visitor& visitor, Rules rules) -> VisitError<typename Visitor::ResultType>
+    {
+        static_assert(
+            meta::is_detected<impl::rules::HasResultType, Visitor>::value,
+            "Visitor must fulfill StaticVisitor requirement and must expose an inner ResultType type"
+        );
+        checkRules<Rules>();
+
+        RawCursor cursor(index.frame(), index.frameSize());
+
+        using ResultType = typename Visitor::ResultType;
+
+        TypedParsingContext<ResultType> context(cursor);
+        context.setLeanErrors(impl::rules::LeanErrors<Rules>::value);
+        impl::indexed::visitMessage(context, index, visitor, rules);
+
+        return context.toVisitError();
+    }
+
+    template<typename Visitor, typename Rules>
+    auto visitIndex(const FieldIndex& index, Visitor& visitor, Rules rules, Arena& arena) -> VisitError<typename Visitor::ResultType>
+    {
+        arena.reset();
+        details::arena::Scope scope(arena.resource());
+
+        return visitIndex(index, visitor, rules);
+    }
+
+    // Visits a frame through the two-stage parser: the frame is first indexed
+    // and the index is then resolved through visitIndex()
 
-    struct VisitRules
+    template<typename Visitor, typename Rules>
+    auto visitIndexed(const char* frame, size_t size, Visitor& visitor, Rules rules) -> VisitError<typename Visitor::ResultType>
     {
-        template<typename... Args>
-        using OverrideSet = meta::map::Map<Args...>;
+        FieldIndex index;
+        if (!index.build(frame, size))
+            return result::Err(ErrorKind(ErrorKind::ParsingError, index.errorOffset(), "Malformed field"));
 
-        template<typename First, typename Second>
-        using Override = meta::map::Pair<First, Second>;
+        return visitIndex(index, visitor, rules);
+    }
 
-        template<typename T> using As = T;
-    };
+    // ------------------------------------------------
+    // visitHeader
+    // ------------------------------------------------
 
+    // Result of visitHeader(): the parsed Header along with the position of the
+    // body, which is left untouched
 
-    template<typename T>
-    struct StaticVisitor
+    template<typename Dictionary>
+    struct HeaderFrame
     {
-        using ResultType = T;
+        using Header = typename Dictionary::Header::Ref;
+
+        HeaderFrame()
+            : bodyLength(0)
+            , bodyOffset(0)
+            , bodySize(0)
+        { }
+
+        Header header;
+
+        View msgType;
+        int bodyLength;
+
+        // The body goes from the first field that is not part of the Header
+        // up to, but excluding, the CheckSum field
+        size_t bodyOffset;
+        size_t bodySize;
     };
 
-    template<typename Visitor, typename Rules, typename Context>
-    void visitMessage(Context& context, Visitor& visitor, Rules rules)
+    template<typename DictionaryT>
+    struct HeaderRules : public VisitRules
     {
-        auto& cursor = context.cursor;
-        auto beginString = impl::matchTag<Tag::BeginString>(cursor);
+        using Overrides = OverrideSet<>;
+        using Dictionary = DictionaryT;
 
-        TRY_ADVANCE("Expected BodyLength after BeginString, got EOFs");
+        static constexpr bool ValidateChecksum = true;
+        static constexpr bool ValidateLength = true;
+        static constexpr bool StrictMode = false;
+        static constexpr bool SkipUnknownTags = false;
+    };
 
-        auto bodyLength = impl::matchTag<Tag::BodyLength>(cursor);
-        if (!bodyLength.first)
+    namespace impl
+    {
+
+        namespace header
         {
-            context.setError(ErrorKind::ParsingError,
-                             "Could not parse BodyLength, expected int, got '%c'",
-                              CURSOR_CURRENT(cursor));
-            return;
-        }
 
-        TRY_ADVANCE("Expected MsgType after BodyLength, got EOF");
-        auto msgType = impl::matchTag<Tag::MsgType>(cursor);
-        TRY_ADVANCE("Expected Header after MsgType, got EOF");
+            template<typename Context>
+            void checkTrailer(Context& context, const char* trailer, const char* last, std::true_type /* ValidateChecksum */)
+            {
+                if (trailer == nullptr)
+                {
+                    context.setError(ErrorKind::InvalidChecksum, "Missing CheckSum");
+                    return;
+                }
 
-        context.setVersion(beginString.second);
-        context.setBodyLength(bodyLength.second);
-        context.setMsgType(msgType.second);
+                validateTrailer(context, trailer, last, std::true_type{});
+            }
 
-        impl::MessageVisitor<Visitor, Rules> messageVisitor(context, visitor);
-        impl::visitMessage(context, messageVisitor, rules);
-    }
+            template<typename Context>
+            void checkTrailer(Context& /*context*/, const char* /*trailer*/, const char* /*last*/, std::false_type /* ValidateChecksum */)
+            {
+            }
 
-    template<typename Rules>
-    static void checkRules()
-    {
-        static_assert(std::is_base_of<VisitRules, Rules>::value, "Visit rules must inherit from VisitRules");
+            template<typename Rules, typename Context, typename Frame>
+            void visit(Context& context, Frame& frame)
+            {
+                using Dictionary = typename Rules::Dictionary;
+                using Version = typename Dictionary::Version;
+                using Header = typename Dictionary::Header::Ref;
 
-        static_assert(
-            meta::is_detected<impl::rules::HasOverrides, Rules>::value,
-            "Visit rules must provide an Overrides typedef"
-        );
-        static_assert(
-            meta::is_detected<impl::rules::HasDictionary, Rules>::value,
-            "Visit rules must provide a Dictionary typedef"
-        );
-        static_assert(
-            meta::is_detected<impl::rules::HasValidateChecksum, Rules>::value,
-            "Visit rules must provide a static ValidateChecksum boolean"
-        );
-        static_assert(
-            meta::is_detected<impl::rules::HasValidateLength, Rules>::value,
-            "Visit rules must provide a static ValidateLength boolean"
-        );
-        static_assert(
-            meta::is_detected<impl::rules::HasStrictMode, Rules>::value,
-            "Visit rules must provide a static StrictMode boolean"
-        );
-        static_assert(
-            meta::is_detected<impl::rules::HasSkipUnknownTags, Rules>::value,
-            "Visit rules must provide a static SkipUnknownTags boolean"
-        );
+                auto& cursor = context.cursor;
 
-        impl::rules::OverridesValidator<typename Rules::Overrides> validator {};
-        (void)validator;
-    }
+                const char* first = cursor.offset();
+                const char* last = first + cursor.remaining();
 
+                auto beginString = matchTag<Tag::BeginString>(cursor);
+                if (!beginString.first)
+                {
+                    context.setError(ErrorKind::ParsingError, "Expected BeginString, got '%c'", CURSOR_CURRENT(cursor));
+                    return;
+                }
 
-    // Note that the Visitor is passed by lvalue-reference, which means that is currently
-    // not possible to pass an rvalue like a lambda or a bind-expression as a Visitor.
-    // @Investigate a way to make it possible as it will be useful with polymorphic lambdas
+                TRY_ADVANCE("Expected BodyLength after BeginString, got EOF");
 
-    template<typename Visitor, typename Rules>
-    auto visit(const char* frame, size_t size, Visitor& visitor, Rules rules) -> VisitError<typename Visitor::ResultType>
+                auto bodyLength = matchTag<Tag::BodyLength>(cursor);
+                if (!bodyLength.first)
+                {
+                    context.setError(ErrorKind::ParsingError,
+                                     "Could not parse BodyLength, expected int, got '%c'",
+                                      CURSOR_CURRENT(cursor));
+                    return;
+                }
+
+                TRY_ADVANCE("Expected MsgType after BodyLength, got EOF");
+
+                context.setVersion(beginString.second);
+                context.setBodyLength(bodyLength.second);
+
+                if (!Version::equals(beginString.second.first, beginString.second.second))
+                {
+                    context.setTagError(ErrorKind::InvalidVersion, Tag::BeginString::Id, beginString.second,
+                            "FIX version mismatched, expected '%s', got '%.*s'",
+                            Version::Str, static_cast<int>(beginString.second.second), beginString.second.first);
+                    return;
+                }
+
+                // When the frame is framed through its BodyLength, the CheckSum is validated
+                // right away, without having to scan the body
+                validateLength<Rules>(context, bodyLength.second, std::integral_constant<bool, Rules::ValidateLength>{});
+                if (context.hasError())
+                    return;
+
+                auto msgType = matchTag<Tag::MsgType>(cursor);
+                if (!msgType.first)
+                {
+                    context.setError(ErrorKind::ParsingError, "Expected MsgType, got '%c'", CURSOR_CURRENT(cursor));
+                    return;
+                }
+
+                TRY_ADVANCE("Expected Header after MsgType, got EOF");
+
+                context.setMsgType(msgType.second);
+
+                // The Header ends on the first field that is not part of it
+                const char* body = last;
+
+                CursorSource<Context> source(context);
+                while (!source.done())
+                {
+                    const char* tagOffset = source.offset();
+
+                    int tag;
+                    if (!source.readTag(&tag))
+                        return;
+
+                    FieldVisitor<Header, CursorSource<Context>> headerVisitor(source, Rules::StrictMode, Rules::SkipUnknownTags);
+                    if (!visitField(frame.header, tag, headerVisitor))
+                    {
+                        body = tagOffset;
+                        break;
+                    }
+
+                    if (context.hasError())
+                        return;
+                }
+
+                const char* trailer = context.trailer;
+                if (trailer == nullptr)
+                {
+                    trailer = findTrailer(body - 1, last);
+                    checkTrailer(context, trailer, last, std::integral_constant<bool, Rules::ValidateChecksum>{});
+                    if (context.hasError())
+                        return;
+                }
+
+                const char* bodyLast = trailer != nullptr ? trailer : last;
+
+                frame.msgType = msgType.second;
+                frame.bodyLength = bodyLength.second;
+                frame.bodyOffset = static_cast<size_t>(body - first);
+                frame.bodySize = bodyLast > body ? static_cast<size_t>(bodyLast - body) : 0;
+            }
+
+        } // namespace header
+
+    } // namespace impl
+
+    // Only parses the Header of a frame, leaving its body untouched. This is all
+    // that is needed to route, sequence-check or persist a frame. The CheckSum and
+    // BodyLength are validated if asked for by the rules
+
+    template<typename Rules>
+    auto visitHeader(const char* frame, size_t size, Rules) -> VisitError<HeaderFrame<typename Rules::Dictionary>>
     {
-        static_assert(
-            meta::is_detected<impl::rules::HasResultType, Visitor>::value,
-            "Visitor must fulfill StaticVisitor requirement and must expose an inner ResultType type"
-        );
         checkRules<Rules>();
 
-        RawStreamBuf<> streambuf(const_cast<char *>(frame), size);
-        StreamCursor cursor(&streambuf);
+        using Result = HeaderFrame<typename Rules::Dictionary>;
 
-        using ResultType = typename Visitor::ResultType;
+        RawCursor cursor(frame, size);
+        TypedParsingContext<Result> context(cursor);
+        context.setLeanErrors(impl::rules::LeanErrors<Rules>::value);
 
-        TypedParsingContext<ResultType> context(cursor);
-        visitMessage(context, visitor, rules);
+        Result result;
+        impl::header::visit<Rules>(context, result);
+
+        if (!context.hasError())
+            context.setValue(result);
 
         return context.toVisitError();
     }
 
+    template<typename Dictionary>
+    auto visitHeader(const char* frame, size_t size) -> VisitError<HeaderFrame<Dictionary>>
+    {
+        return visitHeader(frame, size, HeaderRules<Dictionary>());
+    }
+
     template<typename Tag>
     VisitError<View> visitTagView(const char* frame, size_t size)
     {
-        RawStreamBuf<> streambuf(const_cast<char *>(frame), size);
-        StreamCursor cursor(&streambuf);
+        RawCursor cursor(frame, size);
 
         TypedParsingContext<View> context(cursor);
 
@@ -1232,7 +2575,7 @@ namespace Fixpp
                 );
                 TRY_ADVANCE("Expected value after tag %d, got EOF", tag);
 
-                StreamCursor::Token valueToken(cursor);
+                RawCursor::Token valueToken(cursor);
                 TRY_MATCH_UNTIL(SOH, "Expected value after tag %d, got EOF", tag);
 
                 if (tag == Tag::Id)
@@ -1245,7 +2588,7 @@ namespace Fixpp
 
             } while (!cursor.eof() && !context.hasError());
 
-            context.setError(ErrorKind::UnknownTag, "Could not find tag %d in given frame", Tag::Id);
+            context.setTagError(ErrorKind::UnknownTag, Tag::Id, View(), "Could not find tag %d in given frame", Tag::Id);
         };
 
         doVisitTag();
@@ -1262,6 +2605,218 @@ namespace Fixpp
         });
     }
 
+    template<typename Tag>
+    VisitError<View> visitTagView(const FieldIndex& index)
+    {
+        const auto* entry = index.find(Tag::Id);
+        if (entry == nullptr)
+        {
+            char errStr[64];
+            auto count = std::snprintf(errStr, sizeof errStr, "Could not find tag %d in given frame", Tag::Id);
+            return result::Err(ErrorKind(ErrorKind::UnknownTag, 0, std::string(errStr, count)));
+        }
+
+        return result::Ok(index.view(*entry));
+    }
+
+    template<typename Tag>
+    auto visitTag(const FieldIndex& index) -> VisitError<typename Tag::Type::UnderlyingType>
+    {
+        return visitTagView<Tag>(index).map([](const View& view)
+        {
+            return details::LexicalCast<typename Tag::Type>::cast(view.first, view.second);
+        });
+    }
+
+    // ------------------------------------------------
+    // visitTags
+    // ------------------------------------------------
+
+    // Extracts many tags from a frame in a single pass. Every requested tag is
+    // returned as an optional, empty when the tag could not be found in the frame.
+    // The scan stops as soon as every tag has been found
+
+    namespace impl
+    {
+
+        namespace tags
+        {
+
+            template<size_t Size>
+            constexpr bool unique(const Fixpp::details::tag_table::Keys<Size>& keys)
+            {
+                for (size_t i = 0; i < Size; ++i)
+                {
+                    for (size_t j = i + 1; j < Size; ++j)
+                    {
+                        if (keys.tags[i] == keys.tags[j])
+                            return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template<typename Tag> using OptionalView = std::optional<View>;
+            template<typename Tag> using OptionalValue = std::optional<typename Tag::Type::UnderlyingType>;
+
+            template<typename... Tags>
+            struct Extractor
+            {
+                // Membership of a tag is tested through the same compile-time table
+                // used to look up the fields of a Message
+                using Table = Fixpp::details::TagTable<Tags::Id...>;
+
+                static_assert(sizeof...(Tags) > 0, "Expected at least one tag");
+                static_assert(unique(Table::Keys), "Tags must be unique");
+
+                Extractor()
+                    : found(0)
+                { }
+
+                // Returns true once every tag has been found
+                bool add(unsigned tag, const View& view)
+                {
+                    const int index = Table::of(tag);
+                    if (index == -1 || slots[index])
+                        return false;
+
+                    slots[index] = view;
+                    return ++found == sizeof...(Tags);
+                }
+
+                std::tuple<OptionalView<Tags>...> views() const
+                {
+                    return views(meta::seq::index_sequence_for<Tags...>{});
+                }
+
+                std::tuple<OptionalValue<Tags>...> values() const
+                {
+                    return values(meta::seq::index_sequence_for<Tags...>{});
+                }
+
+            private:
+                template<size_t... Indexes>
+                std::tuple<OptionalView<Tags>...> views(meta::seq::index_sequence<Indexes...>) const
+                {
+                    return std::tuple<OptionalView<Tags>...>(slots[Indexes]...);
+                }
+
+                template<size_t... Indexes>
+                std::tuple<OptionalValue<Tags>...> values(meta::seq::index_sequence<Indexes...>) const
+                {
+                    return std::tuple<OptionalValue<Tags>...>(cast<Tags>(slots[Indexes])...);
+                }
+
+                // Malformed values, like garbled time fields, are left empty as well
+                template<typename Tag>
+                static OptionalValue<Tag> cast(const std::optional<View>& view)
+                {
+                    using Cast = Fixpp::details::RefCast<typename Tag::Type>;
+
+                    typename Cast::StorageType value;
+                    if (!view || !Cast::tryCast(view->first, view->second, &value))
+                        return std::nullopt;
+
+                    return OptionalValue<Tag>(std::in_place, value);
+                }
+
+                std::array<std::optional<View>, sizeof...(Tags)> slots;
+                size_t found;
+            };
+
+            template<typename Context, typename Extractor>
+            void extract(Context& context, Extractor& extractor)
+            {
+                auto& cursor = context.cursor;
+
+                while (!cursor.eof())
+                {
+                    int tag;
+                    TRY_MATCH_INT(
+                        tag,
+                        "Encountered invalid tag, expected int, got '%c'",
+                        CURSOR_CURRENT(cursor)
+                    );
+                    TRY_ADVANCE("Expected value after tag %d, got EOF", tag);
+
+                    // The last field of the frame does not need to be terminated
+                    typename Context::Token valueToken(cursor);
+                    const bool terminated = match_until_fast(SOH, cursor);
+
+                    if (extractor.add(tag, valueToken.view()) || !terminated)
+                        return;
+
+                    cursor.advance(1);
+                }
+            }
+
+        } // namespace tags
+
+    } // namespace impl
+
+    template<typename... Tags>
+    using TagViews = std::tuple<impl::tags::OptionalView<Tags>...>;
+
+    template<typename... Tags>
+    using TagValues = std::tuple<impl::tags::OptionalValue<Tags>...>;
+
+    template<typename... Tags>
+    VisitError<TagViews<Tags...>> visitTagViews(const char* frame, size_t size)
+    {
+        RawCursor cursor(frame, size);
+        TypedParsingContext<TagViews<Tags...>> context(cursor);
+
+        impl::tags::Extractor<Tags...> extractor;
+        impl::tags::extract(context, extractor);
+
+        if (!context.hasError())
+            context.setValue(extractor.views());
+
+        return context.toVisitError();
+    }
+
+    template<typename... Tags>
+    VisitError<TagValues<Tags...>> visitTags(const char* frame, size_t size)
+    {
+        RawCursor cursor(frame, size);
+        TypedParsingContext<TagValues<Tags...>> context(cursor);
+
+        impl::tags::Extractor<Tags...> extractor;
+        impl::tags::extract(context, extractor);
+
+        if (!context.hasError())
+            context.setValue(extractor.values());
+
+        return context.toVisitError();
+    }
+
+    template<typename... Tags>
+    TagViews<Tags...> visitTagViews(const FieldIndex& index)
+    {
+        impl::tags::Extractor<Tags...> extractor;
+        for (const auto& entry: index)
+        {
+            if (extractor.add(entry.tag, index.view(entry)))
+                break;
+        }
+
+        return extractor.views();
+    }
+
+    template<typename... Tags>
+    TagValues<Tags...> visitTags(const FieldIndex& index)
+    {
+        impl::tags::Extractor<Tags...> extractor;
+        for (const auto& entry: index)
+        {
+            if (extractor.add(entry.tag, index.view(entry)))
+                break;
+        }
+
+        return extractor.values();
+    }
+
 #undef TRY_ADVANCE
 #undef TRY_MATCH_INT
 #undef TRY_MATCH_UNTIL
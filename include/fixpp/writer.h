@@ -6,15 +6,23 @@
 
 #pragma once
 
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
 
+#if __cplusplus >= 202002L
+  #include <span>
+#endif
+
 #include <fixpp/tag.h>
 #include <fixpp/dsl.h>
 #include <fixpp/streambuf.h>
 #include <fixpp/utils/soh.h>
+#include <fixpp/utils/time.h>
 
 namespace Fixpp {
 
@@ -67,6 +75,291 @@ namespace details
 
     };
 
+    constexpr size_t countDigits(uint64_t value)
+    {
+        size_t count = 1;
+        while (value >= 10)
+        {
+            value /= 10;
+            ++count;
+        }
+
+        return count;
+    }
+
+    // The "Id=" prefix of a tag, spelled out at compile-time
+    template<unsigned Id>
+    struct TagPrefix
+    {
+        static constexpr size_t Size = countDigits(Id) + 1;
+
+        static constexpr std::array<char, Size> make()
+        {
+            std::array<char, Size> chars {};
+
+            unsigned value = Id;
+            for (size_t i = Size - 1; i-- > 0; value /= 10)
+                chars[i] = static_cast<char>('0' + value % 10);
+
+            chars[Size - 1] = '=';
+            return chars;
+        }
+
+        static constexpr std::array<char, Size> Value = make();
+    };
+
+    // Writes value as exactly width digits, padded with leading zeros
+    inline char* writeDigits(char* p, uint64_t value, size_t width)
+    {
+        for (size_t i = width; i-- > 0; value /= 10)
+            p[i] = static_cast<char>('0' + value % 10);
+
+        return p + width;
+    }
+
+    // A bounded view over caller-owned memory that values are formatted into, without
+    // any stream, locale or allocation. Writing past the end sets the overflow flag
+    // instead of writing anything
+    class FrameBuffer
+    {
+    public:
+        FrameBuffer(char* first, char* last)
+            : first_(first)
+            , cur_(first)
+            , last_(last)
+            , overflow_(false)
+        { }
+
+        // Claims the next size bytes, nullptr if they do not fit
+        char* reserve(size_t size)
+        {
+            if (static_cast<size_t>(last_ - cur_) < size)
+            {
+                overflow_ = true;
+                return nullptr;
+            }
+
+            char* p = cur_;
+            cur_ += size;
+            return p;
+        }
+
+        void put(char c)
+        {
+            if (char* p = reserve(1))
+                *p = c;
+        }
+
+        void append(const char* data, size_t size)
+        {
+            if (char* p = reserve(size))
+                std::memcpy(p, data, size);
+        }
+
+        template<typename Integer>
+        void appendInt(Integer value)
+        {
+            const auto result = std::to_chars(cur_, last_, value);
+            if (result.ec != std::errc())
+                overflow_ = true;
+            else
+                cur_ = result.ptr;
+        }
+
+        // Same output as printf("%.16G")
+        void appendFloat(double value)
+        {
+            const auto result = std::to_chars(cur_, last_, value, std::chars_format::general, 16);
+            if (result.ec != std::errc())
+            {
+                overflow_ = true;
+                return;
+            }
+
+            for (char* p = cur_; p != result.ptr; ++p)
+            {
+                if (*p >= 'a' && *p <= 'z')
+                    *p = static_cast<char>(*p - 'a' + 'A');
+            }
+
+            cur_ = result.ptr;
+        }
+
+        size_t size() const
+        {
+            return static_cast<size_t>(cur_ - first_);
+        }
+
+        bool overflow() const
+        {
+            return overflow_;
+        }
+
+    private:
+        char* first_;
+        char* cur_;
+        char* last_;
+        bool overflow_;
+    };
+
+    namespace format
+    {
+
+        static constexpr int64_t SecondsPerDay = 86400;
+
+        inline int64_t floorDiv(int64_t value, int64_t divisor)
+        {
+            const int64_t quotient = value / divisor;
+            return value % divisor < 0 ? quotient - 1 : quotient;
+        }
+
+        // YYYYMMDD
+        inline char* writeDate(char* p, int64_t days)
+        {
+            const auto date = civil::civilFromDays(days);
+            p = writeDigits(p, static_cast<uint64_t>(date.year), 4);
+            p = writeDigits(p, date.month, 2);
+            return writeDigits(p, date.day, 2);
+        }
+
+        // HH:MM:SS
+        inline char* writeTimeOfDay(char* p, int64_t secs)
+        {
+            p = writeDigits(p, static_cast<uint64_t>(secs / 3600), 2);
+            *p++ = ':';
+            p = writeDigits(p, static_cast<uint64_t>(secs / 60 % 60), 2);
+            *p++ = ':';
+            return writeDigits(p, static_cast<uint64_t>(secs % 60), 2);
+        }
+
+        inline void writeValue(FrameBuffer& buf, char value)
+        {
+            buf.put(value);
+        }
+
+        inline void writeValue(FrameBuffer& buf, int64_t value)
+        {
+            buf.appendInt(value);
+        }
+
+        inline void writeValue(FrameBuffer& buf, const std::string& value)
+        {
+            buf.append(value.data(), value.size());
+        }
+
+        inline void writeValue(FrameBuffer& buf, const Type::Boolean::Boxed& value)
+        {
+            buf.put(value ? 'Y' : 'N');
+        }
+
+        inline void writeValue(FrameBuffer& buf, const Type::Float::Boxed& value)
+        {
+            buf.appendFloat(static_cast<double>(value));
+        }
+
+        inline void writeValue(FrameBuffer& buf, const Type::UTCTimestamp::Time& value)
+        {
+            static constexpr int Divisors[] = { 1000000, 1000, 1 };
+
+            const unsigned precision = value.precision();
+            char* p = buf.reserve(17 + (precision > 0 ? precision + 1 : 0));
+            if (!p)
+                return;
+
+            const int64_t secs = static_cast<int64_t>(value.time());
+            const int64_t days = floorDiv(secs, SecondsPerDay);
+
+            p = writeDate(p, days);
+            *p++ = '-';
+            p = writeTimeOfDay(p, secs - days * SecondsPerDay);
+
+            if (precision > 0)
+            {
+                *p++ = '.';
+                writeDigits(p, static_cast<uint64_t>(value.subsecond() / Divisors[precision / 3 - 1]), precision);
+            }
+        }
+
+        inline void writeValue(FrameBuffer& buf, const Type::UTCDate::Date& value)
+        {
+            if (char* p = buf.reserve(8))
+                writeDate(p, floorDiv(static_cast<int64_t>(value.time()), SecondsPerDay));
+        }
+
+        inline void writeValue(FrameBuffer& buf, const Type::UTCTimeOnly::Time& value)
+        {
+            const auto msec = value.msec();
+            const auto usec = msec ? value.usec() : std::nullopt;
+
+            char* p = buf.reserve(8 + (msec ? 4 : 0) + (usec ? 3 : 0));
+            if (!p)
+                return;
+
+            const int64_t secs = static_cast<int64_t>(value.time());
+            p = writeTimeOfDay(p, secs - floorDiv(secs, SecondsPerDay) * SecondsPerDay);
+
+            if (msec)
+            {
+                *p++ = '.';
+                p = writeDigits(p, static_cast<uint64_t>(*msec), 3);
+                if (usec)
+                    writeDigits(p, static_cast<uint64_t>(*usec), 3);
+            }
+        }
+
+    } // namespace format
+
+    template<typename Tag>
+    void writeTagPrefix(FrameBuffer& buf)
+    {
+        buf.append(TagPrefix<Tag::Id>::Value.data(), TagPrefix<Tag::Id>::Size);
+    }
+
+    template<typename Field>
+    struct FieldFormatter
+    {
+        static void write(FrameBuffer& buf, const Field& field)
+        {
+            writeTagPrefix<typename Field::Tag>(buf);
+            format::writeValue(buf, field.get());
+            buf.put(SOH);
+        }
+    };
+
+    template<typename GroupTag, typename SizeHint, typename... Tags>
+    struct FieldFormatter<Field<SmallRepeatingGroup<GroupTag, SizeHint, Tags...>>>
+    {
+        template<typename FieldT>
+        static void write(FrameBuffer& buf, const FieldT& field)
+        {
+            writeTagPrefix<GroupTag>(buf);
+            buf.appendInt(field.size());
+            buf.put(SOH);
+
+            static constexpr size_t GroupSize = FieldT::TotalTags;
+
+            const auto& group = field.get();
+            for (const auto& instance: group)
+            {
+                doWriteGroupFields(buf, instance, meta::seq::make_index_sequence<GroupSize>{});
+            }
+        }
+
+    private:
+        template<typename Tuple, size_t... Index>
+        static void doWriteGroupFields(FrameBuffer& buf, const Tuple& tuple, meta::seq::index_sequence<Index...>)
+        {
+            int dummy[] = { 0, ((void) doWriteField(buf, meta::get<Index>(tuple.values)), 0)... };
+            (void) dummy;
+        }
+
+        template<typename Field>
+        static void doWriteField(FrameBuffer& buf, const Field& field)
+        {
+            if (!field.empty())
+                FieldFormatter<Field>::write(buf, field);
+        }
+    };
 
 } // namespace details
 
@@ -104,18 +397,7 @@ struct Writer
         StreamBuf<Message> buf;
         std::ostream os(&buf);
 
-        if (!message.requiredBits.all())
-        {
-            std::ostringstream error;
-            const size_t missingBits = message.requiredBits.size() - message.requiredBits.count();
-            error << "Missing " << missingBits << " required value(s) for Message";
-            throw std::runtime_error(error.str());
-        }
-
-        if (!header.requiredBits.all())
-        {
-            throw std::runtime_error("Missing values for header");
-        }
+        checkRequired(header, message);
 
         const auto startOffset = buf.offset();
 
@@ -144,6 +426,95 @@ struct Writer
         return buf.asString();
     }
 
+    // Writes the frame straight into [out, out + capacity), a slot of a send buffer
+    // for example, without going through a stream nor allocating. Returns the size of
+    // the frame, or 0 when it does not fit in capacity, in which case the content of
+    // out is unspecified
+    template<typename Header, typename Message>
+    size_t write(const Header& header, const Message& message, char* out, size_t capacity)
+    {
+        using Version = typename Message::Version;
+
+        checkRequired(header, message);
+
+        // The body is written first, right after room for the largest BodyLength that
+        // could fit in capacity. The header is then written in front of it, the body
+        // being moved back when its length has less digits than reserved
+        static constexpr size_t BeginStringSize = sizeof("8=") + Version::Size;
+        static constexpr size_t CheckSumSize = sizeof("10=000");
+
+        const size_t headerCapacity = BeginStringSize + sizeof("9=") + details::countDigits(capacity);
+        if (capacity < headerCapacity + CheckSumSize)
+            return 0;
+
+        char* end = out + capacity;
+
+        details::FrameBuffer body(out + headerCapacity, end);
+        details::writeTagPrefix<Tag::MsgType>(body);
+        body.append(Message::MsgType::Value, Message::MsgType::Size);
+        body.put(SOH);
+
+        write(body, header.values, meta::seq::make_index_sequence<Header::TotalTags>());
+        write(body, message.values, meta::seq::make_index_sequence<Message::TotalTags>());
+
+        if (body.overflow())
+            return 0;
+
+        const size_t bodySize = body.size();
+
+        char* p = out;
+        std::memcpy(p, "8=", 2);
+        std::memcpy(p + 2, Version::Str, Version::Size);
+        p += BeginStringSize;
+        p[-1] = SOH;
+
+        std::memcpy(p, "9=", 2);
+        p = details::writeDigits(p + 2, bodySize, details::countDigits(bodySize));
+        *p++ = SOH;
+
+        if (p != out + headerCapacity)
+            std::memmove(p, out + headerCapacity, bodySize);
+        p += bodySize;
+
+        if (static_cast<size_t>(end - p) < CheckSumSize)
+            return 0;
+
+        size_t sum = 0;
+        for (const char* c = out; c != p; ++c)
+            sum += static_cast<unsigned char>(*c);
+
+        std::memcpy(p, "10=", 3);
+        p = details::writeDigits(p + 3, sum % 256, 3);
+        *p++ = SOH;
+
+        return static_cast<size_t>(p - out);
+    }
+
+#if defined(__cpp_lib_span)
+    template<typename Header, typename Message>
+    size_t write(const Header& header, const Message& message, std::span<char> out)
+    {
+        return write(header, message, out.data(), out.size());
+    }
+#endif
+
+    template<typename Header, typename Message>
+    void checkRequired(const Header& header, const Message& message)
+    {
+        if (!message.requiredBits.all())
+        {
+            std::ostringstream error;
+            const size_t missingBits = message.requiredBits.size() - message.requiredBits.count();
+            error << "Missing " << missingBits << " required value(s) for Message";
+            throw std::runtime_error(error.str());
+        }
+
+        if (!header.requiredBits.all())
+        {
+            throw std::runtime_error("Missing values for header");
+        }
+    }
+
     template<typename Tuple, size_t... Idx>
     void write(std::ostream& os, const Tuple& tuple, meta::seq::index_sequence<Idx...>)
     {
@@ -157,6 +528,20 @@ struct Writer
         if (!field.empty())
             writeField<Field>(os, field);
     }
+
+    template<typename Tuple, size_t... Idx>
+    void write(details::FrameBuffer& buf, const Tuple& tuple, meta::seq::index_sequence<Idx...>)
+    {
+        int dummy[] = {0, ((void) doWriteField(buf, meta::get<Idx>(tuple)), 0)...};
+        (void) dummy;
+    }
+
+    template<typename Field>
+    void doWriteField(details::FrameBuffer& buf, const Field& field)
+    {
+        if (!field.empty())
+            details::FieldFormatter<Field>::write(buf, field);
+    }
 };
 
 } // namespace Fixpp
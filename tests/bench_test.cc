@@ -1,10 +1,13 @@
 #include <chrono>
 #include <fstream>
+#include <sstream>
 
 #define SOH_CHARACTER '|'
 
 #include <fixpp/versions/v42.h>
 #include <fixpp/visitor.h>
+#include <fixpp/splitter.h>
+#include <fixpp/log.h>
 #include <fixpp/dsl.h>
 
 size_t total = 0;
@@ -57,6 +60,101 @@ std::vector<std::string> readFrames(const char* file)
     return result;
 }
 
+std::string readFile(const char* file)
+{
+    std::ifstream in(file);
+
+    if (!in)
+    {
+        std::cerr << "Could not open '" << file << "'" << std::endl;
+    }
+
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+}
+
+// Splits the stream line by line, copying every frame
+size_t splitWithGetline(const std::string& stream, Visitor& visitor)
+{
+    std::istringstream in(stream);
+    std::string line;
+
+    size_t frames = 0;
+    while (std::getline(in, line))
+    {
+        Fixpp::visit(line.c_str(), line.size(), visitor, VisitRules());
+        ++frames;
+    }
+
+    return frames;
+}
+
+// Splits the stream as it would be received from a socket, in chunks of ChunkSize bytes
+size_t splitWithFrameSplitter(const std::string& stream, Visitor& visitor)
+{
+    static constexpr size_t ChunkSize = 4096;
+
+    Fixpp::FrameSplitter splitter;
+
+    size_t frames = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += ChunkSize)
+    {
+        const auto size = std::min(ChunkSize, stream.size() - offset);
+        frames += splitter.feed(stream.data() + offset, size, [&](const Fixpp::View& frame) {
+            Fixpp::visit(frame.first, frame.second, visitor, VisitRules());
+        });
+    }
+
+    return frames;
+}
+
+template<typename Split>
+void bench(const char* name, const std::string& stream, Split split)
+{
+    static constexpr size_t Iterations = 100;
+
+    Visitor visitor;
+    total = 0;
+
+    size_t frames = 0;
+
+    auto start = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < Iterations; ++i)
+        frames += split(stream, visitor);
+
+    auto end = std::chrono::system_clock::now();
+
+    auto totalUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "[" << name << "] Parsed " << total << "/" << frames << " frames in " << totalUs.count() << "us\n";
+
+    auto frameLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(totalUs) / static_cast<double>(frames);
+    std::cout << "-> " << frameLatencyUs.count() << "us / frame\n";
+}
+
+// Visits the stream in parallel with the given number of workers
+void benchLog(const std::string& stream, size_t workers)
+{
+    static constexpr size_t Iterations = 10;
+
+    std::vector<Visitor> visitors(workers);
+    Fixpp::LogStats stats;
+
+    auto start = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < Iterations; ++i)
+        stats += Fixpp::visitLog(stream.data(), stream.size(), visitors, VisitRules());
+
+    auto end = std::chrono::system_clock::now();
+
+    auto totalUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "[visitLog, " << workers << " workers] Parsed " << stats.frames << " frames in " << totalUs.count() << "us\n";
+
+    auto frameLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(totalUs) / static_cast<double>(stats.frames);
+    std::cout << "-> " << frameLatencyUs.count() << "us / frame\n";
+}
+
 int main()
 {
     auto frames = readFrames("tests/data/fix42.log");
@@ -77,4 +175,18 @@ int main()
 
     auto frameLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(totalUs) / static_cast<double>(frames.size());
     std::cout << "-> " << frameLatencyUs.count() << "us / frame\n";
+
+    const auto stream = readFile("tests/data/fix42.log");
+
+    bench("getline", stream, splitWithGetline);
+    bench("FrameSplitter", stream, splitWithFrameSplitter);
+
+    // Replay a bigger log to give some work to every worker
+    std::string bigStream;
+    for (size_t i = 0; i < 100; ++i)
+        bigStream += stream;
+
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t workers = 1; workers <= cores; workers *= 2)
+        benchLog(bigStream, workers);
 }
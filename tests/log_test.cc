@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+
+#define SOH_CHARACTER '|'
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fixpp/log.h>
+#include <fixpp/versions/v42.h>
+#include <fixpp/utils/mapped_file.h>
+
+namespace
+{
+    // Builds a Heartbeat frame with valid BodyLength and CheckSum fields
+    std::string makeHeartbeat(int seqNum)
+    {
+        const std::string body = "35=0|34=" + std::to_string(seqNum) + "|49=SNDR|56=TRGT|";
+        std::string frame = "8=FIX.4.2|9=" + std::to_string(body.size()) + "|" + body;
+
+        unsigned sum = 0;
+        for (char c: frame)
+            sum += static_cast<unsigned char>(c);
+
+        char checksum[8];
+        std::snprintf(checksum, sizeof checksum, "10=%03u|", sum % 256);
+
+        return frame + checksum;
+    }
+
+    std::string makeLog(int frames)
+    {
+        std::string log;
+        for (int i = 1; i <= frames; ++i)
+            log += makeHeartbeat(i) + "\n";
+
+        return log;
+    }
+
+    struct LogVisitRules : public Fixpp::VisitRules
+    {
+        using Overrides = OverrideSet<>;
+        using Dictionary = Fixpp::v42::Spec::Dictionary;
+
+        static constexpr bool ValidateChecksum = true;
+        static constexpr bool ValidateLength = true;
+        static constexpr bool StrictMode = false;
+        static constexpr bool SkipUnknownTags = false;
+    };
+
+    struct CountVisitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::Heartbeat::Ref&)
+        {
+            ++heartbeats;
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+        }
+
+        size_t heartbeats = 0;
+    };
+
+    struct SeqNumVisitor : public Fixpp::StaticVisitor<int>
+    {
+        int operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Heartbeat::Ref&)
+        {
+            return Fixpp::get<Fixpp::Tag::MsgSeqNum>(header);
+        }
+
+        template<typename HeaderT, typename MessageT> int operator()(HeaderT, MessageT)
+        {
+            return -1;
+        }
+    };
+}
+
+TEST(log_test, should_split_log_on_frame_boundaries)
+{
+    const auto log = makeLog(100);
+
+    for (size_t count = 1; count <= 32; ++count)
+    {
+        auto chunks = Fixpp::splitLog(log.data(), log.size(), count);
+
+        ASSERT_LE(chunks.size(), count);
+        ASSERT_EQ(chunks.front().first, log.data());
+
+        size_t total = 0;
+        for (const auto& chunk: chunks)
+        {
+            ASSERT_EQ(std::string(chunk.first, 5), "8=FIX");
+            ASSERT_EQ(chunk.first, log.data() + total);
+            total += chunk.second;
+        }
+
+        ASSERT_EQ(total, log.size());
+    }
+}
+
+TEST(log_test, should_visit_log_in_parallel)
+{
+    const auto log = makeLog(1000);
+
+    std::vector<CountVisitor> visitors(4);
+    auto stats = Fixpp::visitLog(log.data(), log.size(), visitors, LogVisitRules());
+
+    size_t heartbeats = 0;
+    for (const auto& visitor: visitors)
+        heartbeats += visitor.heartbeats;
+
+    ASSERT_EQ(stats.frames, 1000);
+    ASSERT_EQ(stats.errors, 0);
+    ASSERT_EQ(stats.skipped, 1000);
+    ASSERT_EQ(heartbeats, 1000);
+}
+
+TEST(log_test, should_merge_visited_frames_in_order)
+{
+    const auto log = makeLog(1000);
+
+    std::vector<SeqNumVisitor> visitors(4);
+
+    std::vector<int> seqNums;
+    auto stats = Fixpp::visitLogOrdered(log.data(), log.size(), visitors, LogVisitRules(), [&](int seqNum) {
+        seqNums.push_back(seqNum);
+    });
+
+    ASSERT_EQ(stats.frames, 1000);
+    ASSERT_EQ(seqNums.size(), 1000);
+    for (size_t i = 0; i < seqNums.size(); ++i)
+        ASSERT_EQ(seqNums[i], static_cast<int>(i + 1));
+}
+
+TEST(log_test, should_hand_out_failed_frames_in_order)
+{
+    std::string log;
+    for (int i = 1; i <= 1000; ++i)
+    {
+        auto frame = makeHeartbeat(i);
+
+        // Corrupt the CheckSum of every hundredth frame
+        if (i % 100 == 0)
+            frame[frame.size() - 2] = frame[frame.size() - 2] == '0' ? '1' : '0';
+
+        log += frame + "\n";
+    }
+
+    std::vector<SeqNumVisitor> visitors(4);
+
+    std::vector<int> seqNums;
+    std::vector<std::string> failed;
+    auto stats = Fixpp::visitLogOrdered(log.data(), log.size(), visitors, LogVisitRules(), [&](int seqNum) {
+        seqNums.push_back(seqNum);
+    }, [&](const Fixpp::View& frame, const Fixpp::ErrorKind& error) {
+        ASSERT_EQ(error.type(), Fixpp::ErrorKind::InvalidChecksum);
+
+        // Failed frames are interleaved with the values, in the order of the log
+        failed.emplace_back(frame.first, frame.second);
+        const auto seqNum = "|34=" + std::to_string(seqNums.size() + 1) + "|";
+        ASSERT_NE(failed.back().find(seqNum), std::string::npos);
+
+        seqNums.push_back(0);
+    });
+
+    ASSERT_EQ(stats.frames, 990);
+    ASSERT_EQ(stats.errors, 10);
+    ASSERT_EQ(failed.size(), 10);
+    ASSERT_EQ(seqNums.size(), 1000);
+    for (size_t i = 0; i < seqNums.size(); ++i)
+        ASSERT_EQ(seqNums[i], (i + 1) % 100 == 0 ? 0 : static_cast<int>(i + 1));
+}
+
+TEST(log_test, should_visit_mapped_log)
+{
+    const auto log = makeLog(100);
+    const char* path = "log_test.log";
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << log;
+    }
+
+    {
+        Fixpp::MappedFile file(path);
+        ASSERT_EQ(std::string(file.data(), file.size()), log);
+
+        std::vector<CountVisitor> visitors(2);
+        auto stats = Fixpp::visitLog(file.data(), file.size(), visitors, LogVisitRules());
+        ASSERT_EQ(stats.frames, 100);
+    }
+
+    std::remove(path);
+
+    ASSERT_THROW(Fixpp::MappedFile("does_not_exist.log"), std::runtime_error);
+}
@@ -2,6 +2,7 @@
 
 #include <fixpp/versions/v42.h>
 #include <fixpp/versions/v44.h>
+#include <fixpp/dsl/details/tag_table.h>
 
 TEST(message_test, should_bring_correct_version_with_message_type)
 {
@@ -208,3 +209,20 @@ TEST(message_test, should_set_tag_if_defined)
     int64_t i;
     ASSERT_FALSE(Fixpp::tryUnsafeGet<MyOtherTag>(message, i));
 }
+
+TEST(message_test, should_lookup_tags_in_tag_table)
+{
+    using Table = Fixpp::details::TagTable<35, 49, 11325, 10, 537, 20001, 49>;
+
+    ASSERT_EQ(Table::of(35), 0);
+    ASSERT_EQ(Table::of(49), 1);
+    ASSERT_EQ(Table::of(11325), 2);
+    ASSERT_EQ(Table::of(10), 3);
+    ASSERT_EQ(Table::of(537), 4);
+    ASSERT_EQ(Table::of(20001), 5);
+
+    ASSERT_EQ(Table::of(0), -1);
+    ASSERT_EQ(Table::of(55), -1);
+    ASSERT_EQ(Table::of(5000), -1);
+    ASSERT_EQ(Table::of(11326), -1);
+}
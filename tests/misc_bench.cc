@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <charconv>
+#include <cstdlib>
+
 #include <fixpp/tag.h>
 #include <fixpp/dsl/details/lexical_cast.h>
 
@@ -27,7 +30,69 @@ static void BenchStrptimeUTCTimestampParsing(benchmark::State& state)
     }
 }
 
+static const char* Prices[] = {
+    "00104.840000", "001000000.00", "1.1182", "8.525", "0453665272", "-0.00015"
+};
+
+static void BenchCustomFloatParsing(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (const char* str: Prices)
+            benchmark::DoNotOptimize(Fixpp::details::LexicalCast<Fixpp::Type::Float>::cast(str, std::strlen(str)));
+    }
+}
+
+static void BenchStrtodFloatParsing(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (const char* str: Prices)
+            benchmark::DoNotOptimize(std::strtod(str, nullptr));
+    }
+}
+
+static void BenchFromCharsFloatParsing(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (const char* str: Prices)
+        {
+            double value;
+            std::from_chars(str, str + std::strlen(str), value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+}
+
+static const char* Ints[] = {
+    "35", "1579321", "20170105", "1000000", "002565204", "11325"
+};
+
+static void BenchCustomIntParsing(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (const char* str: Ints)
+            benchmark::DoNotOptimize(Fixpp::details::LexicalCast<Fixpp::Type::Int>::cast(str, std::strlen(str)));
+    }
+}
+
+static void BenchStrtollIntParsing(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (const char* str: Ints)
+            benchmark::DoNotOptimize(std::strtoll(str, nullptr, 10));
+    }
+}
+
 BENCHMARK(BenchCustomUTCTimestampParsing);
 BENCHMARK(BenchStrptimeUTCTimestampParsing);
+BENCHMARK(BenchCustomFloatParsing);
+BENCHMARK(BenchStrtodFloatParsing);
+BENCHMARK(BenchFromCharsFloatParsing);
+BENCHMARK(BenchCustomIntParsing);
+BENCHMARK(BenchStrtollIntParsing);
 
 BENCHMARK_MAIN();
@@ -110,4 +110,47 @@ static void WriteNewOrderSingleBenchmark(benchmark::State& state)
 
 BENCHMARK(WriteNewOrderSingleBenchmark);
 
+static void WriteNewOrderSingleToBufferBenchmark(benchmark::State& state)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    std::uniform_int_distribution<> intDis(1, 10000);
+    std::uniform_real_distribution<> realDis(1.0, 500.0);
+    Fixpp::v42::Message::NewOrderSingle orderSingle;
+
+    std::time_t t = std::time(nullptr);
+
+    Fixpp::set<Fixpp::Tag::Symbol>(orderSingle, "BHP");
+    Fixpp::set<Fixpp::Tag::Side>(orderSingle, '1');
+    Fixpp::set<Fixpp::Tag::HandlInst>(orderSingle, '1');
+
+    Fixpp::set<Fixpp::Tag::OrdType>(orderSingle, '2');
+    Fixpp::set<Fixpp::Tag::TimeInForce>(orderSingle, '4');
+    Fixpp::set<Fixpp::Tag::TransactTime>(orderSingle, t);
+
+    Fixpp::v42::Header header;
+    Fixpp::set<Fixpp::Tag::SenderCompID>(header, "TEX_DLD");
+    Fixpp::set<Fixpp::Tag::TargetCompID>(header, "DLD_TEX");
+    Fixpp::set<Fixpp::Tag::SendingTime>(header, t);
+
+    size_t i = 0;
+
+    Fixpp::Writer writer;
+    char buffer[512];
+
+    while (state.KeepRunning())
+    {
+        Fixpp::set<Fixpp::Tag::OrderQty>(orderSingle, static_cast<double>(intDis(gen)));
+        Fixpp::set<Fixpp::Tag::Price>(orderSingle, realDis(gen));
+
+        auto id = makeId(i++);
+        Fixpp::set<Fixpp::Tag::ClOrdID>(orderSingle, id + "-50000");
+
+        benchmark::DoNotOptimize(writer.write(header, orderSingle, buffer, sizeof buffer));
+    }
+}
+
+BENCHMARK(WriteNewOrderSingleToBufferBenchmark);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,189 @@
+#include "gtest/gtest.h"
+
+#define SOH_CHARACTER '|'
+
+#include <string>
+#include <vector>
+
+#include <fixpp/splitter.h>
+#include <fixpp/versions/v42.h>
+#include <fixpp/visitor.h>
+
+namespace
+{
+    const std::string Logon = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068|";
+    const std::string Heartbeat = "8=FIX.4.2|9=0022|35=0|49=Prov|56=MDABC|10=233|";
+
+    struct Frames
+    {
+        void operator()(const Fixpp::View& view)
+        {
+            frames.emplace_back(view.first, view.second);
+        }
+
+        std::vector<std::string> frames;
+    };
+
+    std::vector<std::string> split(Fixpp::FrameSplitter& splitter, const std::string& stream, size_t chunkSize)
+    {
+        Frames result;
+        for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+        {
+            const auto size = std::min(chunkSize, stream.size() - offset);
+            splitter.feed(stream.data() + offset, size, std::ref(result));
+        }
+
+        return result.frames;
+    }
+}
+
+TEST(splitter_test, should_split_many_frames_in_a_single_chunk)
+{
+    const std::string stream = Logon + Heartbeat + Logon;
+
+    Fixpp::FrameSplitter splitter;
+
+    std::vector<const char*> offsets;
+    auto count = splitter.feed(stream.data(), stream.size(), [&](const Fixpp::View& view) {
+        offsets.push_back(view.first);
+    });
+
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(splitter.pending(), 0);
+    ASSERT_EQ(splitter.skipped(), 0);
+
+    // Frames that are fully held by the chunk must not be copied
+    ASSERT_EQ(offsets[0], stream.data());
+    ASSERT_EQ(offsets[1], stream.data() + Logon.size());
+    ASSERT_EQ(offsets[2], stream.data() + Logon.size() + Heartbeat.size());
+}
+
+TEST(splitter_test, should_reassemble_frames_straddling_chunks)
+{
+    const std::string stream = Logon + Heartbeat + Logon + Heartbeat;
+
+    for (size_t chunkSize = 1; chunkSize <= stream.size(); ++chunkSize)
+    {
+        Fixpp::FrameSplitter splitter;
+        auto frames = split(splitter, stream, chunkSize);
+
+        ASSERT_EQ(frames.size(), 4) << "chunk size " << chunkSize;
+        ASSERT_EQ(frames[0], Logon);
+        ASSERT_EQ(frames[1], Heartbeat);
+        ASSERT_EQ(frames[2], Logon);
+        ASSERT_EQ(frames[3], Heartbeat);
+        ASSERT_EQ(splitter.pending(), 0);
+        ASSERT_EQ(splitter.skipped(), 0);
+    }
+}
+
+TEST(splitter_test, should_keep_partial_frames_pending)
+{
+    const std::string stream = Logon + Heartbeat.substr(0, 20);
+
+    Fixpp::FrameSplitter splitter;
+    auto frames = split(splitter, stream, stream.size());
+
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(splitter.pending(), 20);
+}
+
+TEST(splitter_test, should_skip_bytes_between_frames)
+{
+    const std::string stream = Logon + "\n" + Heartbeat + "\r\ngarbage" + Logon;
+
+    for (size_t chunkSize = 1; chunkSize <= stream.size(); ++chunkSize)
+    {
+        Fixpp::FrameSplitter splitter;
+        auto frames = split(splitter, stream, chunkSize);
+
+        ASSERT_EQ(frames.size(), 3) << "chunk size " << chunkSize;
+        ASSERT_EQ(frames[0], Logon);
+        ASSERT_EQ(frames[1], Heartbeat);
+        ASSERT_EQ(frames[2], Logon);
+        ASSERT_EQ(splitter.skipped(), 10);
+    }
+}
+
+TEST(splitter_test, should_resync_after_corrupted_frame)
+{
+    // BodyLength does not land on the CheckSum
+    const std::string corrupted = "8=FIX.4.2|9=10|35=0|49=Prov|56=MDABC|10=213|";
+    const std::string stream = corrupted + Heartbeat + Logon;
+
+    for (size_t chunkSize = 1; chunkSize <= stream.size(); ++chunkSize)
+    {
+        Fixpp::FrameSplitter splitter;
+        auto frames = split(splitter, stream, chunkSize);
+
+        ASSERT_EQ(frames.size(), 2) << "chunk size " << chunkSize;
+        ASSERT_EQ(frames[0], Heartbeat);
+        ASSERT_EQ(frames[1], Logon);
+    }
+
+    // BodyLength runs past the following frames, which must not be lost whatever
+    // the size of the chunks
+    const std::string overlong = "8=FIX.4.2|9=150|35=0|49=Prov|56=MDABC|10=213|";
+    const std::string overlongStream = overlong + Heartbeat + Logon + Heartbeat + Logon;
+
+    for (size_t chunkSize = 1; chunkSize <= overlongStream.size(); ++chunkSize)
+    {
+        Fixpp::FrameSplitter splitter;
+        auto frames = split(splitter, overlongStream, chunkSize);
+
+        ASSERT_EQ(frames.size(), 4) << "chunk size " << chunkSize;
+        ASSERT_EQ(frames[0], Heartbeat);
+        ASSERT_EQ(frames[1], Logon);
+        ASSERT_EQ(frames[2], Heartbeat);
+        ASSERT_EQ(frames[3], Logon);
+
+        ASSERT_EQ(splitter.skipped(), overlong.size()) << "chunk size " << chunkSize;
+        ASSERT_EQ(splitter.pending(), 0);
+    }
+}
+
+struct SplitVisitRules : public Fixpp::VisitRules
+{
+    using Overrides = OverrideSet<>;
+    using Dictionary = Fixpp::v42::Spec::Dictionary;
+
+    static constexpr bool ValidateChecksum = true;
+    static constexpr bool ValidateLength = true;
+    static constexpr bool StrictMode = false;
+    static constexpr bool SkipUnknownTags = false;
+};
+
+struct SplitVisitor : public Fixpp::StaticVisitor<void>
+{
+    void operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::Logon::Ref&)
+    {
+        ++logons;
+    }
+
+    template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+    {
+    }
+
+    size_t logons = 0;
+};
+
+TEST(splitter_test, should_visit_split_frames)
+{
+    const std::string stream = Logon + Heartbeat + Logon;
+
+    Fixpp::FrameSplitter splitter;
+    SplitVisitor visitor;
+
+    size_t errors = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += 7)
+    {
+        const auto size = std::min<size_t>(7, stream.size() - offset);
+        splitter.feed(stream.data() + offset, size, [&](const Fixpp::View& frame) {
+            if (!Fixpp::visit(frame.first, frame.second, visitor, SplitVisitRules()).isOk())
+                ++errors;
+        });
+    }
+
+    ASSERT_EQ(errors, 0);
+    ASSERT_EQ(visitor.logons, 2);
+}
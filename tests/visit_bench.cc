@@ -7,6 +7,9 @@
 #include <fixpp/versions/v42.h>
 #include <fixpp/visitor.h>
 
+#include <string>
+#include <vector>
+
 using MyTag1 = Fixpp::TagT<11325, Fixpp::Type::Int>;
 using MyTag2 = Fixpp::TagT<537, Fixpp::Type::Int>;
 using MyQuote = Fixpp::ExtendedMessage<Fixpp::v42::Message::Quote, Fixpp::Tag::QuoteRequestType, Fixpp::Tag::SettlmntTyp, MyTag1, MyTag2>;
@@ -24,6 +27,21 @@ struct MyVisitRules : public Fixpp::VisitRules
     static constexpr bool SkipUnknownTags = false;
 };
 
+struct MyReuseVisitRules : public MyVisitRules
+{
+    static constexpr bool ReuseMessages = true;
+};
+
+struct MyStrictVisitRules : public MyVisitRules
+{
+    static constexpr bool StrictMode = true;
+};
+
+struct MyLeanStrictVisitRules : public MyStrictVisitRules
+{
+    static constexpr bool LeanErrors = true;
+};
+
 struct MyVisitor : public Fixpp::StaticVisitor<void>
 {
     void operator()(const Fixpp::v42::Header::Ref&, const MyQuote::Ref&)
@@ -49,6 +67,29 @@ struct GetVisitor : public Fixpp::StaticVisitor<void>
     }
 };
 
+struct EntriesVisitor : public Fixpp::StaticVisitor<void>
+{
+    void operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::MarketDataIncrementalRefresh::Ref& refresh)
+    {
+        for (const auto& entry: Fixpp::get<Fixpp::Tag::NoMDEntries>(refresh))
+            benchmark::DoNotOptimize(Fixpp::get<Fixpp::Tag::MDEntryPx>(entry));
+    }
+
+    template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+    {
+    }
+};
+
+struct ProjectedGetVisitor : public GetVisitor
+{
+    using Projection = Fixpp::Projection<MyTag1, MyTag2, Fixpp::Tag::BidPx>;
+};
+
+struct StopProjectedGetVisitor : public GetVisitor
+{
+    using Projection = Fixpp::Projection<Fixpp::StopAfter<MyTag1>, Fixpp::StopAfter<MyTag2>, Fixpp::StopAfter<Fixpp::Tag::BidPx>>;
+};
+
 static void VisitCustomQuoteBenchmark(benchmark::State& state)
 {
     const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
@@ -67,6 +108,67 @@ static void VisitCustomQuoteBenchmark(benchmark::State& state)
 
 }
 
+static void VisitCustomQuoteReuseBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    MyVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visit(frame, size, visitor, MyReuseVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
+// A frame with an unknown tag, rejected in StrictMode
+static const char* UnknownTagFrame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11326=0|10=088|";
+
+static void VisitErrorBenchmark(benchmark::State& state)
+{
+    const size_t size = std::strlen(UnknownTagFrame);
+
+    MyVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        auto err = Fixpp::visit(UnknownTagFrame, size, visitor, MyStrictVisitRules());
+        benchmark::DoNotOptimize(err.isErr());
+    }
+}
+
+static void VisitLeanErrorBenchmark(benchmark::State& state)
+{
+    const size_t size = std::strlen(UnknownTagFrame);
+
+    MyVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        auto err = Fixpp::visit(UnknownTagFrame, size, visitor, MyLeanStrictVisitRules());
+        benchmark::DoNotOptimize(err.isErr());
+    }
+}
+
+static void VisitHeaderBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visitHeader(frame, size, MyVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
 static void VisitCustomQuoteAndGetTagsBenchmark(benchmark::State& state)
 {
     const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
@@ -84,6 +186,143 @@ static void VisitCustomQuoteAndGetTagsBenchmark(benchmark::State& state)
     }
 }
 
+template<typename Visitor>
+static void visitProjectedQuote(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    Visitor visitor;
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visit(frame, size, visitor, MyVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
+static void VisitCustomQuoteAndGetProjectedTagsBenchmark(benchmark::State& state)
+{
+    visitProjectedQuote<ProjectedGetVisitor>(state);
+}
+
+static void VisitCustomQuoteAndGetProjectedTagsStopBenchmark(benchmark::State& state)
+{
+    visitProjectedQuote<StopProjectedGetVisitor>(state);
+}
+
+static void VisitIncrementalRefreshAndGetEntriesBenchmark(benchmark::State& state)
+{
+    const char* frame = "8=FIX.4.2|9=391|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
+                        "279=2|55=CHF/JPY|269=0|278=0453665272|270=00104.840000|271=001000000.00|15=CHF|"
+                        "279=0|55=CHF/JPY|269=0|278=0453665276|270=00104.841000|271=001000000.00|15=CHF|"
+                        "279=2|55=CHF/JPY|269=1|278=0453665273|270=00104.855000|271=001000000.00|15=CHF|"
+                        "279=0|55=CHF/JPY|269=1|278=0453665277|270=00104.856000|271=001000000.00|15=CHF|"
+                        "10=183|";
+
+    const size_t size = std::strlen(frame);
+
+    EntriesVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visit(frame, size, visitor, MyVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
+// An incremental refresh with more entries than the inline storage of the group
+static std::string makeLargeRefresh(size_t entries)
+{
+    std::string body = "35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=" + std::to_string(entries) + "|";
+    for (size_t i = 0; i < entries; ++i)
+        body += "279=0|55=CHF/JPY|269=0|278=0453665272|270=00104.840000|271=001000000.00|15=CHF|";
+
+    return "8=FIX.4.2|9=" + std::to_string(body.size()) + "|" + body + "10=000|";
+}
+
+static void VisitLargeIncrementalRefreshBenchmark(benchmark::State& state)
+{
+    const auto frame = makeLargeRefresh(static_cast<size_t>(state.range(0)));
+
+    EntriesVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visit(frame.data(), frame.size(), visitor, MyVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
+static void VisitLargeIncrementalRefreshWithArenaBenchmark(benchmark::State& state)
+{
+    const auto frame = makeLargeRefresh(static_cast<size_t>(state.range(0)));
+
+    EntriesVisitor visitor;
+    Fixpp::Arena arena(256 * 1024);
+
+    while (state.KeepRunning())
+    {
+        Fixpp::visit(frame.data(), frame.size(), visitor, MyVisitRules(), arena).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
+static void VisitBatchCustomQuoteBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    // A burst of frames, as received by a single recv()
+    std::vector<Fixpp::View> frames(static_cast<size_t>(state.range(0)), Fixpp::make_view(frame, size));
+    std::vector<Fixpp::FrameStatus> statuses(frames.size());
+
+    MyVisitor visitor;
+
+    while (state.KeepRunning())
+    {
+        auto visited = Fixpp::visitBatch(frames.data(), frames.size(), visitor, MyVisitRules(), statuses.data());
+        if (visited != frames.size())
+            state.SkipWithError("Failed to visit frame");
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void VisitIndexedCustomQuoteBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    MyVisitor visitor;
+    Fixpp::FieldIndex index;
+
+    while (state.KeepRunning())
+    {
+        if (!index.build(frame, size))
+        {
+            state.SkipWithError("Failed to index frame");
+            break;
+        }
+
+        Fixpp::visitIndex(index, visitor, MyVisitRules()).otherwise([&](const Fixpp::ErrorKind& e) {
+            auto errStr = e.asString();
+            state.SkipWithError(errStr.c_str());
+        });
+    }
+}
+
 static void VisitTagViewBenchmark(benchmark::State& state)
 {
     const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
@@ -114,9 +353,53 @@ static void VisitTagBenchmark(benchmark::State& state)
     }
 }
 
+static void VisitRoutingTagViewsBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    using namespace Fixpp;
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(visitTagView<Tag::MsgType>(frame, size));
+        benchmark::DoNotOptimize(visitTagView<Tag::SenderCompID>(frame, size));
+        benchmark::DoNotOptimize(visitTagView<Tag::MsgSeqNum>(frame, size));
+        benchmark::DoNotOptimize(visitTagView<Tag::Symbol>(frame, size));
+    }
+}
+
+static void VisitRoutingTagsBenchmark(benchmark::State& state)
+{
+    const char *frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087|";
+
+    const size_t size = std::strlen(frame);
+
+    using namespace Fixpp;
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(visitTagViews<Tag::MsgType, Tag::SenderCompID, Tag::MsgSeqNum, Tag::Symbol>(frame, size));
+    }
+}
+
 BENCHMARK(VisitCustomQuoteBenchmark);
+BENCHMARK(VisitCustomQuoteReuseBenchmark);
+BENCHMARK(VisitBatchCustomQuoteBenchmark)->Arg(1)->Arg(64)->Arg(256);
+BENCHMARK(VisitIndexedCustomQuoteBenchmark);
 BENCHMARK(VisitCustomQuoteAndGetTagsBenchmark);
+BENCHMARK(VisitCustomQuoteAndGetProjectedTagsBenchmark);
+BENCHMARK(VisitCustomQuoteAndGetProjectedTagsStopBenchmark);
+BENCHMARK(VisitIncrementalRefreshAndGetEntriesBenchmark);
+BENCHMARK(VisitLargeIncrementalRefreshBenchmark)->Arg(64)->Arg(512);
+BENCHMARK(VisitLargeIncrementalRefreshWithArenaBenchmark)->Arg(64)->Arg(512);
+BENCHMARK(VisitErrorBenchmark);
+BENCHMARK(VisitLeanErrorBenchmark);
+BENCHMARK(VisitHeaderBenchmark);
 BENCHMARK(VisitTagViewBenchmark);
 BENCHMARK(VisitTagBenchmark);
+BENCHMARK(VisitRoutingTagViewsBenchmark);
+BENCHMARK(VisitRoutingTagsBenchmark);
 
 BENCHMARK_MAIN();
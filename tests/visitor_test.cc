@@ -2,6 +2,10 @@
 
 #define SOH_CHARACTER '|'
 
+#include <cstdio>
+#include <optional>
+#include <string>
+
 #include <fixpp/versions/v42.h>
 #include <fixpp/versions/v44.h>
 #include <fixpp/visitor.h>
@@ -64,6 +68,69 @@ namespace should_visit_message_with_multiple_chars_message_type
 
 } // namespace should_visit_logon_frame
 
+namespace should_visit_batch_of_frames
+{
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Logon::Ref& logon)
+        {
+            ASSERT_EQ(Fixpp::get<Fixpp::Tag::SenderCompID>(header), "ABC");
+            ASSERT_EQ(Fixpp::get<Fixpp::Tag::HeartBtInt>(logon), 60);
+            ++logons;
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+
+        size_t logons = 0;
+    };
+
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+} // namespace should_visit_batch_of_frames
+
+namespace should_skip_unhandled_messages
+{
+    struct Visitor : public Fixpp::StaticVisitor<int>
+    {
+        int operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::Logon::Ref&)
+        {
+            return 1;
+        }
+
+        template<typename HeaderT, typename MessageT> int operator()(HeaderT header, MessageT)
+        {
+            std::string senderCompId;
+            return Fixpp::tryGet<Fixpp::Tag::SenderCompID>(header, senderCompId) ? 2 : 0;
+        }
+    };
+
+    struct SkipRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+    {
+        static constexpr bool SkipUnhandledMessages = true;
+    };
+
+    struct SkipChecksumOnlyRules : public SkipRules
+    {
+        static constexpr bool ValidateLength = false;
+    };
+
+    struct StrictSkipRules : public SkipRules
+    {
+        static constexpr bool StrictMode = true;
+    };
+
+    using Header = Fixpp::v42::Header::Ref;
+
+    static_assert(Fixpp::impl::HandlesMessage<Visitor, Header, Fixpp::v42::Message::Logon::Ref>::value,
+                  "Logon should be handled by a dedicated overload");
+    static_assert(!Fixpp::impl::HandlesMessage<Visitor, Header, Fixpp::v42::Message::Heartbeat::Ref>::value,
+                  "Heartbeat should only be handled by the catch-all overload");
+
+} // namespace should_skip_unhandled_messages
+
 namespace should_try_get_fields_after_parsing
 {
     struct Visitor : public Fixpp::StaticVisitor<void>
@@ -539,6 +606,275 @@ namespace should_skip_unknown_tags
     };
 }
 
+namespace should_visit_projected_fields
+{
+    struct Visitor : public Fixpp::StaticVisitor<int>
+    {
+        int operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Logon::Ref& logon)
+        {
+            EXPECT_EQ(Fixpp::get<Fixpp::Tag::HeartBtInt>(logon), 60);
+            EXPECT_FALSE(Fixpp::tryGet<Fixpp::Tag::EncryptMethod>(logon).has_value());
+            EXPECT_FALSE(Fixpp::tryGet<Fixpp::Tag::SenderCompID>(header).has_value());
+            EXPECT_FALSE(Fixpp::tryGet<Fixpp::Tag::ResetSeqNumFlag>(logon).has_value());
+
+            return Fixpp::tryGet<Fixpp::Tag::MsgSeqNum>(header).value_or(-2);
+        }
+
+        template<typename HeaderT, typename MessageT> int operator()(HeaderT, MessageT)
+        {
+            return -1;
+        }
+    };
+
+    // The Projection of the Visitor takes precedence over the one of the rules
+    struct ProjectedVisitor : public Visitor
+    {
+        using Projection = Fixpp::Projection<Fixpp::Tag::HeartBtInt>;
+    };
+
+    struct VisitRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+    {
+        using Projection = Fixpp::Projection<Fixpp::Tag::MsgSeqNum, Fixpp::Tag::HeartBtInt>;
+    };
+
+    struct StopRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+    {
+        using Projection = Fixpp::Projection<Fixpp::Tag::MsgSeqNum, Fixpp::StopAfter<Fixpp::Tag::HeartBtInt>>;
+    };
+
+    struct ChecksumOnlyStopRules : public StopRules
+    {
+        static constexpr bool ValidateLength = false;
+    };
+
+    struct GroupRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+    {
+        using Projection = Fixpp::Projection<Fixpp::Tag::NoMsgTypes>;
+    };
+
+} // namespace should_visit_projected_fields
+
+namespace should_reuse_messages
+{
+    struct VisitRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+    {
+        static constexpr bool ReuseMessages = true;
+    };
+
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Logon::Ref& logon)
+        {
+            headers.push_back(&header);
+            logons.push_back(&logon);
+
+            heartBtInts.push_back(Fixpp::tryGet<Fixpp::Tag::HeartBtInt>(logon).value_or(-1));
+            msgTypes.push_back(Fixpp::get<Fixpp::Tag::NoMsgTypes>(logon).size());
+            unparsed.push_back(logon.unparsed.size());
+
+            // Visiting a frame from the visitor does not clobber the cached Refs
+            if (nested != nullptr)
+            {
+                const char* frame = nested;
+                nested = nullptr;
+
+                ASSERT_TRUE(Fixpp::visit(frame, std::strlen(frame), *this, VisitRules()).isOk());
+                ASSERT_EQ(Fixpp::get<Fixpp::Tag::SenderCompID>(header), "ABC");
+            }
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+
+        std::vector<const void*> headers;
+        std::vector<const void*> logons;
+
+        std::vector<int> heartBtInts;
+        std::vector<size_t> msgTypes;
+        std::vector<size_t> unparsed;
+
+        const char* nested = nullptr;
+    };
+
+} // namespace should_reuse_messages
+
+namespace should_view_repeating_group_instances
+{
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::MarketDataIncrementalRefresh::Ref& message)
+        {
+            using namespace Fixpp;
+
+            auto mdEntries = Fixpp::get<Tag::NoMDEntries>(message);
+            ASSERT_EQ(mdEntries.size(), 4);
+            ASSERT_FALSE(mdEntries.empty());
+
+            // Instances are not copied
+            ASSERT_EQ(&Fixpp::get<Tag::NoMDEntries>(message)[0], &mdEntries[0]);
+            ASSERT_EQ(&mdEntries.front(), mdEntries.begin());
+            ASSERT_EQ(&mdEntries.back(), mdEntries.end() - 1);
+            ASSERT_THROW(mdEntries.at(4), std::out_of_range);
+
+            std::vector<char> entryTypes;
+            for (const auto& entry: mdEntries)
+                entryTypes.push_back(Fixpp::get<Tag::MDEntryType>(entry));
+
+            ASSERT_EQ(entryTypes, (std::vector<char> { '0', '0', '1', '1' }));
+            ASSERT_EQ(Fixpp::get<Tag::MDEntryPx>(mdEntries.at(3)), 104.856);
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+    };
+
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+} // namespace should_view_repeating_group_instances
+
+namespace should_visit_with_arena
+{
+    // Builds a Logon frame with more instances and unknown tags than the inline
+    // storage of the Ref can hold
+    std::string makeFrame(int instances)
+    {
+        std::string body = "35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|98=0|108=30|";
+        for (int i = 0; i < instances; ++i)
+            body += std::to_string(9000 + i) + "=X|";
+
+        body += "384=" + std::to_string(instances) + "|";
+        for (int i = 0; i < instances; ++i)
+            body += "372=T" + std::to_string(i) + "|385=S|";
+
+        std::string frame = "8=FIX.4.2|9=" + std::to_string(body.size()) + "|" + body;
+
+        unsigned sum = 0;
+        for (char c: frame)
+            sum += static_cast<unsigned char>(c);
+
+        char checksum[8];
+        std::snprintf(checksum, sizeof checksum, "10=%03u|", sum % 256);
+
+        return frame + checksum;
+    }
+
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref&, const Fixpp::v42::Message::Logon::Ref& logon)
+        {
+            auto msgTypes = Fixpp::get<Fixpp::Tag::NoMsgTypes>(logon);
+
+            instances = msgTypes.size();
+            lastMsgType = Fixpp::get<Fixpp::Tag::RefMsgType>(msgTypes.back());
+            unparsed = logon.unparsed.size();
+
+            groupStorage = msgTypes.begin();
+            unparsedStorage = logon.unparsed.data();
+
+            copy.emplace(logon);
+
+            // Containers grown by the visitor itself outlive the frame
+            for (int i = 0; i < 16; ++i)
+                grown.push_back(i);
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+
+        size_t instances = 0;
+        std::string lastMsgType;
+        size_t unparsed = 0;
+
+        const void* groupStorage = nullptr;
+        const void* unparsedStorage = nullptr;
+
+        std::optional<Fixpp::v42::Message::Logon::Ref> copy;
+        Fixpp::ArenaVector<int, 1> grown;
+    };
+
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+} // namespace should_visit_with_arena
+
+namespace should_view_string_fields
+{
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        explicit Visitor(const std::string& frame)
+            : frame(frame)
+        { }
+
+        void operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Logon::Ref& logon)
+        {
+            static_assert(std::is_same<decltype(Fixpp::get<Fixpp::Tag::SenderCompID>(header)), std::string_view>::value,
+                          "String fields of Ref messages should be read as std::string_view");
+
+            auto sender = Fixpp::get<Fixpp::Tag::SenderCompID>(header);
+            ASSERT_EQ(sender, "ABC");
+            ASSERT_TRUE(sender.data() >= frame.data() && sender.data() < frame.data() + frame.size());
+
+            std::optional<std::string_view> target = Fixpp::tryGet<Fixpp::Tag::TargetCompID>(header);
+            ASSERT_EQ(target.value(), "TT_ORDER");
+
+            auto msgTypes = Fixpp::get<Fixpp::Tag::NoMsgTypes>(logon);
+            ASSERT_EQ(Fixpp::get<Fixpp::Tag::RefMsgType>(msgTypes[1]), "TEST2");
+
+            std::string copy;
+            ASSERT_TRUE(Fixpp::tryGet<Fixpp::Tag::TargetCompID>(header, copy));
+            ASSERT_EQ(copy, "TT_ORDER");
+
+            std::string_view view = Fixpp::getView<Fixpp::Tag::TargetCompID>(header);
+            ASSERT_EQ(view, "TT_ORDER");
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+
+        const std::string& frame;
+    };
+
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+} // namespace should_view_string_fields
+
+namespace should_not_get_malformed_time_fields
+{
+    struct Visitor : public Fixpp::StaticVisitor<void>
+    {
+        void operator()(const Fixpp::v42::Header::Ref& header, const Fixpp::v42::Message::Logon::Ref&)
+        {
+            // get() does not hand back a valid-looking time
+            ASSERT_THROW(Fixpp::get<Fixpp::Tag::SendingTime>(header), std::runtime_error);
+
+            ASSERT_FALSE(Fixpp::tryGet<Fixpp::Tag::SendingTime>(header).has_value());
+
+            Fixpp::Type::UTCTimestamp::Time sendingTime(42);
+            ASSERT_FALSE(Fixpp::tryGet<Fixpp::Tag::SendingTime>(header, sendingTime));
+            ASSERT_EQ(sendingTime.time(), 42);
+
+            // Other fields are still read
+            ASSERT_EQ(Fixpp::tryGet<Fixpp::Tag::MsgSeqNum>(header).value(), 1);
+            ASSERT_EQ(Fixpp::tryGet<Fixpp::Tag::SenderCompID>(header).value(), "ABC");
+        }
+
+        template<typename HeaderT, typename MessageT> void operator()(HeaderT, MessageT)
+        {
+            ASSERT_TRUE(false);
+        }
+    };
+
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+} // namespace should_not_get_malformed_time_fields
+
 struct AssertVisitRules : public Fixpp::VisitRules
 {
     using Overrides = OverrideSet<>;
@@ -550,6 +886,11 @@ struct AssertVisitRules : public Fixpp::VisitRules
     static constexpr bool SkipUnknownTags = false;
 };
 
+struct LeanAssertVisitRules : public AssertVisitRules
+{
+    static constexpr bool LeanErrors = true;
+};
+
 struct AssertVisitor : public Fixpp::StaticVisitor<void>
 {
     template<typename Header, typename Message>
@@ -571,6 +912,145 @@ Fixpp::VisitError<typename Visitor::ResultType> doVisit(const char* frame, Visit
     return Fixpp::visit(frame, std::strlen(frame), visitor, rules);
 }
 
+template<typename Visitor, typename Rules>
+Fixpp::VisitError<typename Visitor::ResultType> doVisitIndexed(const char* frame, Visitor visitor, Rules rules)
+{
+    return Fixpp::visitIndexed(frame, std::strlen(frame), visitor, rules);
+}
+
+// Every SIMD kernel the host can run, whichever one is selected at runtime
+std::vector<Fixpp::simd::details::Kernels> simdKernels()
+{
+    using namespace Fixpp::simd::details;
+
+    std::vector<Kernels> kernels;
+#if defined(FIXPP_SIMD_SSE2)
+    kernels.push_back(Kernels { &findSSE2, &sumSSE2, &bitmapSSE2 });
+#endif
+#if defined(FIXPP_SIMD_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+        kernels.push_back(Kernels { &findAVX2, &sumAVX2, &bitmapAVX2 });
+#endif
+
+    return kernels;
+}
+
+TEST(visitor_test, should_find_delimiter_across_simd_boundaries)
+{
+    const auto kernels = simdKernels();
+
+    std::string buffer(100, 'A');
+
+    for (size_t size = 0; size <= buffer.size(); ++size)
+    {
+        for (size_t pos = 0; pos <= size; ++pos)
+        {
+            std::string str = buffer.substr(0, size);
+            if (pos < size)
+                str[pos] = '|';
+
+            const char* first = str.data();
+            const char* last = first + str.size();
+            ASSERT_EQ(Fixpp::simd::find(first, last, '|'), first + pos);
+            ASSERT_EQ(Fixpp::simd::sum(first, last), Fixpp::simd::details::sumScalar(first, last));
+
+            ASSERT_EQ(Fixpp::simd::details::findScalar(first, last, '|'), first + pos);
+            for (const auto& kernel: kernels)
+            {
+                ASSERT_EQ(kernel.find(first, last, '|'), first + pos) << "size " << size;
+                ASSERT_EQ(kernel.sum(first, last), Fixpp::simd::details::sumScalar(first, last)) << "size " << size;
+            }
+        }
+    }
+}
+
+TEST(visitor_test, should_match_tags_with_raw_and_stream_cursors)
+{
+    const char* frame = "8=FIX.4.2|9=84|35=A|";
+    const size_t size = std::strlen(frame);
+
+    RawCursor rawCursor(frame, size);
+    auto rawTag = Fixpp::impl::matchTag<Fixpp::Tag::BeginString>(rawCursor);
+    ASSERT_TRUE(rawTag.first);
+    ASSERT_EQ(std::string(rawTag.second.first, rawTag.second.second), "FIX.4.2");
+    ASSERT_EQ(static_cast<size_t>(rawCursor), 9);
+
+    RawStreamBuf<> streambuf(const_cast<char *>(frame), size);
+    StreamCursor streamCursor(&streambuf);
+    auto streamTag = Fixpp::impl::matchTag<Fixpp::Tag::BeginString>(streamCursor);
+    ASSERT_TRUE(streamTag.first);
+    ASSERT_EQ(std::string(streamTag.second.first, streamTag.second.second), "FIX.4.2");
+    ASSERT_EQ(static_cast<size_t>(streamCursor), 9);
+
+    ASSERT_FALSE(Fixpp::impl::matchTag<Fixpp::Tag::MsgType>(rawCursor).first);
+    ASSERT_EQ(static_cast<size_t>(rawCursor), 9);
+}
+
+TEST(visitor_test, should_parse_int)
+{
+    const char* values[] = {
+        "0", "7", "-7", "35", "1579321", "12345678", "123456789", "00000000000000000042",
+        "1234567890123456", "123456789012345678", "9223372036854775807", "-9223372036854775808"
+    };
+
+    for (const char* str: values)
+    {
+        auto value = Fixpp::details::LexicalCast<Fixpp::Type::Int>::cast(str, std::strlen(str));
+        ASSERT_EQ(value, std::strtoll(str, nullptr, 10)) << str;
+    }
+
+    // Parsing stops at the end of the value
+    const char* str = "1234|5678";
+    ASSERT_EQ(Fixpp::details::LexicalCast<Fixpp::Type::Int>::cast(str, 2), 12);
+    ASSERT_EQ(Fixpp::details::LexicalCast<Fixpp::Type::Int>::cast(str, std::strlen(str)), 1234);
+
+    // Values that overflow are rejected
+    ASSERT_EQ(Fixpp::details::LexicalCast<Fixpp::Type::Int>::cast("9223372036854775808", 19), 0);
+}
+
+TEST(visitor_test, should_match_bounded_int)
+{
+    const char* str = "123456789012=A";
+
+    int value;
+    RawCursor cursor(str, std::strlen(str));
+    ASSERT_TRUE(match_int_fast_n(&value, cursor, 4));
+    ASSERT_EQ(value, 1234);
+    ASSERT_EQ(static_cast<size_t>(cursor), 4);
+
+    ASSERT_TRUE(match_int_fast_n(&value, cursor, 5));
+    ASSERT_EQ(value, 56789);
+
+    ASSERT_TRUE(match_int_fast(&value, cursor));
+    ASSERT_EQ(value, 12);
+    ASSERT_EQ(cursor.current(), '=');
+    ASSERT_FALSE(match_int_fast(&value, cursor));
+
+    // Values that do not fit in an int are rejected
+    RawCursor overflow(str, std::strlen(str));
+    ASSERT_FALSE(match_int_fast(&value, overflow));
+    ASSERT_EQ(static_cast<size_t>(overflow), 0);
+}
+
+TEST(visitor_test, should_parse_float)
+{
+    const char* values[] = {
+        "0", "1", "-1", "0.1", "1.1182", "00104.840000", "001000000.00", "-0.5", ".25",
+        "9007199254740993", "123456789012345678901.5", "3.14159265358979323846",
+        "0.0000000000000000000000001", "1234567.890123", "99999999.99999999"
+    };
+
+    for (const char* str: values)
+    {
+        auto value = Fixpp::details::LexicalCast<Fixpp::Type::Float>::cast(str, std::strlen(str));
+        ASSERT_EQ(value, std::strtod(str, nullptr)) << str;
+    }
+
+    // Parsing stops at the end of the value
+    const char* str = "1.25|270=2";
+    ASSERT_EQ(Fixpp::details::LexicalCast<Fixpp::Type::Float>::cast(str, 3), 1.2);
+}
+
 TEST(visitor_test, should_parse_utc_date)
 {
     const char* str = "20171105";
@@ -639,6 +1119,130 @@ TEST(visitor_test, should_parse_utc_time_with_microseconds)
     ASSERT_EQ(time.usec().value(), 456);
 }
 
+TEST(visitor_test, should_parse_utc_timestamp_with_nanoseconds)
+{
+    const char* str = "20171105-14:09:30.125456789";
+    auto time = Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::cast(str, std::strlen(str));
+
+    ASSERT_EQ(time.time(), 1509890970);
+    ASSERT_EQ(time.subsecond(), 125456789);
+    ASSERT_EQ(time.precision(), 9);
+
+    ASSERT_EQ(time.msec().value(), 125);
+    ASSERT_EQ(time.usec().value(), 456);
+    ASSERT_EQ(time.nsec().value(), 789);
+
+    std::chrono::system_clock::time_point timePoint = time;
+    ASSERT_EQ(std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count(), 1509890970125456789);
+}
+
+TEST(visitor_test, should_parse_utc_timestamp_with_picoseconds)
+{
+    // Picoseconds are truncated to nanoseconds
+    const char* str = "20171105-14:09:30.125456789123";
+
+    Fixpp::Type::UTCTimestamp::Time time;
+    ASSERT_TRUE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast(str, std::strlen(str), &time));
+
+    ASSERT_EQ(time.time(), 1509890970);
+    ASSERT_EQ(time.subsecond(), 125456789);
+    ASSERT_EQ(time.precision(), 9);
+
+    ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast("20171105-14:09:30.12345678912x", 30, &time));
+}
+
+TEST(visitor_test, should_parse_utc_timestamp_with_explicit_precision)
+{
+    const char* str = "20171105-14:09:30.000";
+    auto time = Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::cast(str, std::strlen(str));
+
+    ASSERT_EQ(time.time(), 1509890970);
+    ASSERT_EQ(time.precision(), 3);
+    ASSERT_EQ(time.msec().value(), 0);
+    ASSERT_FALSE(time.usec());
+
+    str = "20171105-14:09:30.100000";
+    time = Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::cast(str, std::strlen(str));
+
+    ASSERT_EQ(time.precision(), 6);
+    ASSERT_EQ(time.msec().value(), 100);
+    ASSERT_EQ(time.usec().value(), 0);
+}
+
+TEST(visitor_test, should_parse_utc_timestamp_across_dates)
+{
+    for (int year: { 1970, 1999, 2000, 2016, 2100, 2200, 2400 })
+    {
+        for (int month = 1; month <= 12; ++month)
+        {
+            std::tm tm{};
+            tm.tm_year = year - 1900;
+            tm.tm_mon = month - 1;
+            tm.tm_mday = month == 2 ? 28 + Fixpp::civil::isLeapYear(year) : 30;
+            tm.tm_hour = 23;
+            tm.tm_min = 59;
+            tm.tm_sec = 58;
+
+            char str[32];
+            std::strftime(str, sizeof str, "%Y%m%d-%H:%M:%S", &tm);
+
+            // Nanoseconds since the Epoch only cover the years up to 2261
+            Fixpp::Type::UTCTimestamp::Time time;
+            const bool parsed = Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast(str, std::strlen(str), &time);
+
+            ASSERT_EQ(parsed, year < 2262) << str;
+            if (parsed)
+                ASSERT_EQ(time.time(), timegm(&tm)) << str;
+        }
+    }
+}
+
+TEST(visitor_test, should_not_parse_out_of_range_utc_timestamp)
+{
+    // The usual "never expires" sentinel
+    const char* str = "99991231-23:59:59";
+
+    Fixpp::Type::UTCTimestamp::Time time;
+    ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast(str, std::strlen(str), &time));
+    ASSERT_THROW(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::cast(str, std::strlen(str)), std::runtime_error);
+
+    ASSERT_TRUE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast("22620411-23:47:15", 17, &time));
+    ASSERT_EQ(time.time(), Fixpp::Type::UTCTimestamp::Time::MaxSeconds);
+    ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast("22620411-23:47:16", 17, &time));
+
+    std::tm tm{};
+    tm.tm_year = 9999 - 1900;
+    tm.tm_mon = 11;
+    tm.tm_mday = 31;
+    ASSERT_THROW(Fixpp::Type::UTCTimestamp::Time{mkgmtime(&tm)}, std::out_of_range);
+    ASSERT_THROW(Fixpp::Type::UTCTimestamp::Time{std::chrono::sys_days{std::chrono::year{9999}/12/31}}, std::out_of_range);
+}
+
+TEST(visitor_test, should_not_parse_malformed_utc_timestamp)
+{
+    const char* values[] = {
+        "", "2017110514:09:30", "20171105-14:09", "20171305-14:09:30", "20170229-14:09:30",
+        "20171105-24:09:30", "20171105-14:60:30", "20171105-14:09:3a", "20171105-14-09-30",
+        "20171105-14:09:30.", "20171105-14:09:30.12", "20171105-14:09:30.12x", "20171105-14:09:30.1234567890"
+    };
+
+    for (const char* str: values)
+    {
+        Fixpp::Type::UTCTimestamp::Time time;
+        ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast(str, std::strlen(str), &time)) << str;
+    }
+
+    ASSERT_THROW(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::cast("2017", 4), std::runtime_error);
+    ASSERT_THROW(Fixpp::details::LexicalCast<Fixpp::Type::UTCDate>::cast("20171132", 8), std::runtime_error);
+    ASSERT_THROW(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimeOnly>::cast("14:09:30.1", 10), std::runtime_error);
+
+    Fixpp::Type::UTCDate::Date date;
+    ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCDate>::tryCast("20171132", 8, &date));
+
+    Fixpp::Type::UTCTimeOnly::Time timeOnly;
+    ASSERT_FALSE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimeOnly>::tryCast("14:09:30.1", 10, &timeOnly));
+}
+
 TEST(visitor_test, should_parse_utc_timestamp)
 {
     const char* str = "20171105-14:09:30";
@@ -701,33 +1305,33 @@ TEST(visitor_test, should_parse_utc_timestamp_with_microseconds)
 
 TEST(visitor_test, should_visit_logon_frame)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+    const char* frame = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
     auto err = doVisit(frame, should_visit_logon_frame::Visitor(), should_visit_logon_frame::VisitRules());
     ASSERT_TRUE(err.isOk());
 }
 
 TEST(visitor_test, should_visit_repeating_group_in_logon_frame)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=248";
+    const char* frame = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221";
     auto err = doVisit(frame, should_visit_repeating_group_in_logon_frame::Visitor(), should_visit_repeating_group_in_logon_frame::VisitRules());
     ASSERT_TRUE(err.isOk());
 }
 
 TEST(visitor_test, should_visit_custom_message)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|2154=1212|98=0|108=60|141=Y|10=248";
+    const char* frame = "8=FIX.4.2|9=90|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|2154=1212|98=0|108=60|141=Y|10=144";
     auto err = doVisit(frame, should_visit_custom_message::Visitor(), should_visit_custom_message::MyVisitRules());
     ASSERT_TRUE(err.isOk());
 }
 
 TEST(visitor_test, should_visit_incremental_refresh_frame)
 {
-    const char* frame = "8=FIX.4.2|9=407|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
+    const char* frame = "8=FIX.4.2|9=391|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
                         "279=2|55=CHF/JPY|269=0|278=0453665272|270=00104.840000|271=001000000.00|15=CHF|"
                         "279=0|55=CHF/JPY|269=0|278=0453665276|270=00104.841000|271=001000000.00|15=CHF|"
                         "279=2|55=CHF/JPY|269=1|278=0453665273|270=00104.855000|271=001000000.00|15=CHF|"
                         "279=0|55=CHF/JPY|269=1|278=0453665277|270=00104.856000|271=001000000.00|15=CHF|"
-                        "10=213";
+                        "10=183";
 
     auto err = doVisit(frame, should_visit_incremental_refresh_frame::Visitor(), should_visit_incremental_refresh_frame::VisitRules());
     ASSERT_TRUE(err.isOk());
@@ -735,10 +1339,10 @@ TEST(visitor_test, should_visit_incremental_refresh_frame)
 
 TEST(visitor_test, should_visit_snapshot_frame)
 {
-    const char* frame = "8=FIX.4.4|9=0230|35=W|49=Prov|56=MDABC|34=2289004|52=20161229-16:18:09.098|55=AUD/CAD|262=1709|268=2|"
+    const char* frame = "8=FIX.4.4|9=0220|35=W|49=Prov|56=MDABC|34=2289004|52=20161229-16:18:09.098|55=AUD/CAD|262=1709|268=2|"
                         "269=0|270=0.97285|271=500000|272=20170103|299=02z00000hdi:A|9063=MP|"
                         "269=1|270=0.97309|271=500000|272=20170103|299=02z00000hdi:A|9063=TP|"
-                        "10=233|";
+                        "10=235|";
 
     using Visitor = should_visit_custom_snapshot_frame::Visitor;
     using VisitRules = should_visit_custom_snapshot_frame::VisitRules;
@@ -749,7 +1353,7 @@ TEST(visitor_test, should_visit_snapshot_frame)
 
 TEST(visitor_test, should_visit_nested_repeating_groups)
 {
-    const char* frame = "8=FIX.4.4|9=0000|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
+    const char* frame = "8=FIX.4.4|9=0206|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
                         "711=1|"
                             "311=AUD/CAD|"
                             "457=1|"
@@ -758,21 +1362,21 @@ TEST(visitor_test, should_visit_nested_repeating_groups)
                         "292=D|268=2|"
                             "269=0|271=500000|272=20170103|299=02z00000hdi:A|"
                             "269=1|271=500000|272=20170103|299=02z00000hdi:A|"
-                        "10=213";
+                        "10=019";
     auto err = doVisit(frame, should_visit_nested_repeating_groups::Visitor(), should_visit_nested_repeating_groups::VisitRules());
     ASSERT_TRUE(err.isOk());
 }
 
 TEST(visitor_test, should_visit_empty_repeating_group)
 {
-    const char* frame = "8=FIX.4.4|9=0000|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|268=0|10=213";
+    const char* frame = "8=FIX.4.4|9=0048|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|268=0|10=187";
     auto err = doVisit(frame, should_visit_empty_repeating_group::Visitor(), should_visit_empty_repeating_group::VisitRules());
     ASSERT_TRUE(err.isOk());
 }
 
 TEST(visitor_test, should_visit_unknown_tags_in_non_strict_mode)
 {
-    const char* frame = "8=FIX.4.4|9=0000|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
+    const char* frame = "8=FIX.4.4|9=0290|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
                         "10721=CUSTOM1|"
                         "711=1|"
                             "311=AUD/CAD|"
@@ -783,7 +1387,7 @@ TEST(visitor_test, should_visit_unknown_tags_in_non_strict_mode)
                         "292=D|268=2|"
                             "269=0|271=500000|272=20170103|299=02z00000hdi:A|10331=CUSTOM5|"
                             "269=1|271=500000|272=20170103|299=02z00000hdi:A|10331=CUSTOM6|"
-                        "10=213";
+                        "10=174";
     using Visitor = should_visit_unknown_tags_in_non_strict_mode::Visitor;
     using VisitRules = should_visit_unknown_tags_in_non_strict_mode::VisitRules;
 
@@ -793,7 +1397,7 @@ TEST(visitor_test, should_visit_unknown_tags_in_non_strict_mode)
 
 TEST(visitor_test, should_stop_when_encountering_invalid_fix_version)
 {
-    const char* frame = "8=FIX.5.1|9=0000|35=0|49=Prov|56=MDABC|10=213";
+    const char* frame = "8=FIX.5.1|9=0022|35=0|49=Prov|56=MDABC|10=233";
 
     auto error = doVisit(frame, AssertVisitor(), AssertVisitRules());
     ASSERT_FALSE(error.isOk());
@@ -802,9 +1406,170 @@ TEST(visitor_test, should_stop_when_encountering_invalid_fix_version)
     ASSERT_EQ(errorKind.type(), Fixpp::ErrorKind::InvalidVersion);
 }
 
+struct ChecksumOnlyTestRules : public DefaultTestRules<Fixpp::v42::Spec::Dictionary>
+{
+    static constexpr bool ValidateLength = false;
+};
+
+TEST(visitor_test, should_stop_when_encountering_invalid_checksum)
+{
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+    const char* frame = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+    auto error = doVisit(frame, AssertVisitor(), VisitRules());
+    ASSERT_FALSE(error.isOk());
+    ASSERT_EQ(error.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    const char* noChecksumFrame = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|";
+    auto missingError = doVisit(noChecksumFrame, AssertVisitor(), ChecksumOnlyTestRules());
+    ASSERT_FALSE(missingError.isOk());
+    ASSERT_EQ(missingError.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+}
+
+TEST(visitor_test, should_stop_when_encountering_invalid_body_length)
+{
+    using VisitRules = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+    const char* frames[] = {
+        // Truncated frame
+        "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|",
+        // Missing CheckSum
+        "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|",
+        // BodyLength too short
+        "8=FIX.4.2|9=70|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068",
+        // BodyLength too long
+        "8=FIX.4.2|9=81|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068",
+        // Trailing bytes after the CheckSum
+        "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068|8=FIX",
+        // Invalid BodyLength
+        "8=FIX.4.2|9=0|35=A|10=068"
+    };
+
+    for (auto frame: frames)
+    {
+        auto error = doVisit(frame, AssertVisitor(), VisitRules());
+        ASSERT_FALSE(error.isOk());
+        ASSERT_EQ(error.unwrapErr().type(), Fixpp::ErrorKind::InvalidLength);
+    }
+}
+
+TEST(visitor_test, should_skip_unhandled_messages)
+{
+    using namespace should_skip_unhandled_messages;
+
+    const char* logon = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    const char* heartbeat = "8=FIX.4.2|9=0022|35=0|49=Prov|56=MDABC|10=233";
+    const char* invalidHeartbeat = "8=FIX.4.2|9=0022|35=0|49=Prov|56=MDABC|10=234";
+
+    auto logonResult = doVisit(logon, Visitor(), DefaultTestRules<Fixpp::v42::Spec::Dictionary>());
+    ASSERT_TRUE(logonResult.isOk());
+    ASSERT_EQ(logonResult.unwrap(), 1);
+
+    // By default, the catch-all gets a fully parsed Header
+    auto parsed = doVisit(heartbeat, Visitor(), DefaultTestRules<Fixpp::v42::Spec::Dictionary>());
+    ASSERT_TRUE(parsed.isOk());
+    ASSERT_EQ(parsed.unwrap(), 2);
+
+    // Unless skipping is asked for, in which case it gets an empty Header
+    auto skipped = doVisit(heartbeat, Visitor(), SkipRules());
+    ASSERT_TRUE(skipped.isOk());
+    ASSERT_EQ(skipped.unwrap(), 0);
+
+    // StrictMode still parses every message
+    auto strict = doVisit(heartbeat, Visitor(), StrictSkipRules());
+    ASSERT_TRUE(strict.isOk());
+    ASSERT_EQ(strict.unwrap(), 2);
+
+    // The CheckSum is still validated, with or without BodyLength
+    auto invalid = doVisit(invalidHeartbeat, Visitor(), SkipRules());
+    ASSERT_FALSE(invalid.isOk());
+    ASSERT_EQ(invalid.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    auto invalidNoLength = doVisit(invalidHeartbeat, Visitor(), SkipChecksumOnlyRules());
+    ASSERT_FALSE(invalidNoLength.isOk());
+    ASSERT_EQ(invalidNoLength.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    auto validNoLength = doVisit(heartbeat, Visitor(), SkipChecksumOnlyRules());
+    ASSERT_TRUE(validNoLength.isOk());
+}
+
+TEST(visitor_test, should_visit_batch_of_frames)
+{
+    const char* logon = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    const char* invalidChecksum = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+    const char* unknownMessage = "8=FIX.4.2|9=23|35=ZZ|49=Prov|56=MDABC|10=014";
+
+    const Fixpp::View frames[] = {
+        Fixpp::make_view(logon, std::strlen(logon)),
+        Fixpp::make_view(invalidChecksum, std::strlen(invalidChecksum)),
+        Fixpp::make_view(unknownMessage, std::strlen(unknownMessage)),
+        Fixpp::make_view(logon, std::strlen(logon))
+    };
+
+    should_visit_batch_of_frames::Visitor visitor;
+    auto statuses = Fixpp::visitBatch(frames, 4, visitor, should_visit_batch_of_frames::VisitRules());
+
+    ASSERT_EQ(visitor.logons, 2);
+    ASSERT_EQ(statuses.size(), 4);
+    ASSERT_EQ(statuses[0], Fixpp::FrameStatus::Ok);
+    ASSERT_EQ(statuses[1], Fixpp::FrameStatus::InvalidChecksum);
+    ASSERT_EQ(statuses[2], Fixpp::FrameStatus::UnknownMessage);
+    ASSERT_EQ(statuses[3], Fixpp::FrameStatus::Ok);
+
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::Incomplete), Fixpp::FrameStatus::Incomplete);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::ParsingError), Fixpp::FrameStatus::ParsingError);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::UnknownTag), Fixpp::FrameStatus::UnknownTag);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::UnknownMessage), Fixpp::FrameStatus::UnknownMessage);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::InvalidVersion), Fixpp::FrameStatus::InvalidVersion);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::InvalidTag), Fixpp::FrameStatus::InvalidTag);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::InvalidChecksum), Fixpp::FrameStatus::InvalidChecksum);
+    ASSERT_EQ(Fixpp::toFrameStatus(Fixpp::ErrorKind::InvalidLength), Fixpp::FrameStatus::InvalidLength);
+}
+
+TEST(visitor_test, should_copy_deferred_values)
+{
+    Fixpp::Deferred<std::string> value;
+    value.construct("a string that does not fit in the small buffer");
+
+    Fixpp::Deferred<std::string> copy(value);
+    ASSERT_FALSE(copy.isEmpty());
+    ASSERT_EQ(copy.get(), value.get());
+    ASSERT_NE(copy.get().data(), value.get().data());
+
+    Fixpp::Deferred<std::string> moved(std::move(copy));
+    ASSERT_EQ(moved.get(), value.get());
+
+    Fixpp::Deferred<std::string> empty;
+    moved = empty;
+    ASSERT_TRUE(moved.isEmpty());
+
+    moved = value;
+    ASSERT_EQ(moved.get(), value.get());
+
+    empty = std::move(moved);
+    ASSERT_EQ(empty.get(), value.get());
+}
+
+TEST(visitor_test, should_stop_when_encountering_unknown_message_type)
+{
+    const char* frames[] = {
+        "8=FIX.4.2|9=0000|35=ZZ|49=Prov|56=MDABC|10=213",
+        "8=FIX.4.2|9=0000|35=U|49=Prov|56=MDABC|10=213",
+        "8=FIX.4.2|9=0000|35=?|49=Prov|56=MDABC|10=213",
+        "8=FIX.4.2|9=0000|35=ABC|49=Prov|56=MDABC|10=213"
+    };
+
+    for (auto frame: frames)
+    {
+        auto error = doVisit(frame, AssertVisitor(), AssertVisitRules());
+        ASSERT_FALSE(error.isOk());
+        ASSERT_EQ(error.unwrapErr().type(), Fixpp::ErrorKind::UnknownMessage);
+    }
+}
+
 TEST(visitor_test, should_stop_in_strict_mode_when_encountering_an_unknown_tag)
 {
-    const char* frame = "8=FIX.4.2|9=0000|35=0|49=Prov|56=MDABC|221=A|10=213";
+    const char* frame = "8=FIX.4.2|9=0028|35=0|49=Prov|56=MDABC|221=A|10=126";
 
     auto error = doVisit(frame, AssertVisitor(), AssertVisitRules());
     ASSERT_FALSE(error.isOk());
@@ -812,11 +1577,37 @@ TEST(visitor_test, should_stop_in_strict_mode_when_encountering_an_unknown_tag)
     auto errorKind = error.unwrapErr();
     ASSERT_EQ(errorKind.type(), Fixpp::ErrorKind::UnknownTag);
     ASSERT_EQ(errorKind.asString(), "Encountered unknown tag 221");
+    ASSERT_EQ(errorKind.tag(), 221);
+}
+
+TEST(visitor_test, should_report_lean_errors)
+{
+    const char* frame = "8=FIX.4.2|9=0028|35=0|49=Prov|56=MDABC|221=A|10=126";
+
+    auto error = doVisit(frame, AssertVisitor(), LeanAssertVisitRules());
+    ASSERT_FALSE(error.isOk());
+
+    auto errorKind = error.unwrapErr();
+    ASSERT_EQ(errorKind.type(), Fixpp::ErrorKind::UnknownTag);
+    ASSERT_EQ(errorKind.tag(), 221);
+    ASSERT_EQ(std::string(errorKind.view().first, errorKind.view().second), "A");
+    ASSERT_EQ(errorKind.asString().find("Encountered unknown tag 221"), 0);
+
+    const char* versionFrame = "8=FIX.4.4|9=0028|35=0|49=Prov|56=MDABC|10=126";
+
+    auto versionError = doVisit(versionFrame, AssertVisitor(), LeanAssertVisitRules());
+    ASSERT_FALSE(versionError.isOk());
+
+    auto versionErrorKind = versionError.unwrapErr();
+    ASSERT_EQ(versionErrorKind.type(), Fixpp::ErrorKind::InvalidVersion);
+    ASSERT_EQ(versionErrorKind.tag(), Fixpp::Tag::BeginString::Id);
+    ASSERT_EQ(std::string(versionErrorKind.view().first, versionErrorKind.view().second), "FIX.4.4");
+    ASSERT_NE(versionErrorKind.asString().find("'FIX.4.4'"), std::string::npos);
 }
 
 TEST(visitor_test, should_try_get_fields_after_parsing)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=248";
+    const char* frame = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221";
 
     auto err = doVisit(frame, should_try_get_fields_after_parsing::Visitor(), should_try_get_fields_after_parsing::VisitRules());
     ASSERT_TRUE(err.isOk());
@@ -824,7 +1615,7 @@ TEST(visitor_test, should_try_get_fields_after_parsing)
 
 TEST(visitor_test, should_be_able_to_return_value_in_visitor)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=248";
+    const char* frame = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221";
 
     auto err = doVisit(frame, should_be_able_to_return_value_in_visitor::Visitor(), should_be_able_to_return_value_in_visitor::VisitRules());
     ASSERT_EQ(err.unwrapOr(0), 10);
@@ -832,7 +1623,7 @@ TEST(visitor_test, should_be_able_to_return_value_in_visitor)
 
 TEST(visitor_test, should_visit_tag)
 {
-    const char* frame = "8=FIX.4.2|9=84|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=248|";
+    const char* frame = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221|";
 
     auto assertFalse = [&](const Fixpp::ErrorKind&) { ASSERT_TRUE(false); };
 
@@ -845,7 +1636,7 @@ TEST(visitor_test, should_visit_tag)
         .otherwise(assertFalse);
 
     Fixpp::visitTag<Fixpp::Tag::BodyLength>(frame, std::strlen(frame))
-        .then([&](int64_t length) { ASSERT_EQ(length, 84); })
+        .then([&](int64_t length) { ASSERT_EQ(length, 92); })
         .otherwise(assertFalse);
 
     Fixpp::visitTag<Fixpp::Tag::OnBehalfOfCompID>(frame, std::strlen(frame))
@@ -855,12 +1646,12 @@ TEST(visitor_test, should_visit_tag)
 
 TEST(visitor_test, should_convert_from_ref)
 {
-    const char* frame = "8=FIX.4.2|9=407|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
+    const char* frame = "8=FIX.4.2|9=391|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
                         "279=2|55=CHF/JPY|269=0|278=0453665272|270=00104.840000|271=001000000.00|15=CHF|"
                         "279=0|55=CHF/JPY|269=0|278=0453665276|270=00104.841000|271=001000000.00|15=CHF|"
                         "279=2|55=CHF/JPY|269=1|278=0453665273|270=00104.855000|271=001000000.00|15=CHF|"
                         "279=0|55=CHF/JPY|269=1|278=0453665277|270=00104.856000|271=001000000.00|15=CHF|"
-                        "10=213";
+                        "10=183";
 
     auto err = doVisit(frame, should_convert_from_ref::Visitor(), should_convert_from_ref::VisitRules());
     ASSERT_TRUE(err.isOk());
@@ -868,7 +1659,7 @@ TEST(visitor_test, should_convert_from_ref)
 
 TEST(visitor_test, should_visit_message_with_multiple_chars_message_type)
 {
-    const char* frame = "8=FIX.4.4|9=84|35=BF|923=123|924=1|553=username|10=248";
+    const char* frame = "8=FIX.4.4|9=33|35=BF|923=123|924=1|553=username|10=201";
 
     auto err = doVisit(frame, should_visit_message_with_multiple_chars_message_type::Visitor(), should_visit_message_with_multiple_chars_message_type::VisitRules());
     ASSERT_TRUE(err.isOk());
@@ -876,11 +1667,469 @@ TEST(visitor_test, should_visit_message_with_multiple_chars_message_type)
 
 TEST(visitor_test, should_skip_unknown_tags)
 {
-    const char* frame = "8=FIX.4.4|9=0234|35=W|49=SNDR|59=ABC|34=1|52=20170609-09:27:24|55=AAA/BBB|262=123|268=2|"
+    const char* frame = "8=FIX.4.4|9=0206|35=W|49=SNDR|59=ABC|34=1|52=20170609-09:27:24|55=AAA/BBB|262=123|268=2|"
                         "269=0|270=1.181|271=50000|272=20170613|299=ABCDEFGH|9063=AB|"
                         "269=1|270=1.1182|271=50000|272=20170613|299=ABCDEFH|9063=AB|"
-                        "9066=189718761|10=076|";
+                        "9066=189718761|10=204|";
 
     auto err = doVisit(frame, should_skip_unknown_tags::Visitor(), should_skip_unknown_tags::VisitRules());
     ASSERT_TRUE(err.isOk());
 }
+
+TEST(visitor_test, should_compute_structural_bitmap_across_simd_boundaries)
+{
+    std::string buffer;
+    for (size_t i = 0; i < 200; ++i)
+        buffer += "0123=|"[i % 6];
+
+    for (size_t size = 0; size <= buffer.size(); ++size)
+    {
+        const char* first = buffer.data();
+        const char* last = first + size;
+
+        std::vector<uint64_t> bits((size + 63) / 64, 0);
+        std::vector<uint64_t> expected((size + 63) / 64, 0);
+
+        Fixpp::simd::bitmap(first, last, '=', '|', bits.data());
+        Fixpp::simd::details::bitmapScalar(first, last, '=', '|', expected.data());
+        ASSERT_EQ(bits, expected) << "size " << size;
+
+        for (const auto& kernel: simdKernels())
+        {
+            std::vector<uint64_t> kernelBits((size + 63) / 64, 0);
+            kernel.bitmap(first, last, '=', '|', kernelBits.data());
+            ASSERT_EQ(kernelBits, expected) << "size " << size;
+        }
+    }
+}
+
+TEST(visitor_test, should_index_fields_of_a_frame)
+{
+    const char* frame = "8=FIX.4.2|9=19|35=A|58=a=b|108=60|10=054|";
+
+    Fixpp::FieldIndex index;
+    ASSERT_TRUE(index.build(frame, std::strlen(frame)));
+    ASSERT_EQ(index.size(), 6);
+
+    const unsigned tags[] = { 8, 9, 35, 58, 108, 10 };
+    const char* values[] = { "FIX.4.2", "19", "A", "a=b", "60", "054" };
+
+    for (size_t i = 0; i < index.size(); ++i)
+    {
+        ASSERT_EQ(index[i].tag, tags[i]);
+
+        auto view = index.view(i);
+        ASSERT_EQ(std::string(view.first, view.second), values[i]);
+        ASSERT_EQ(frame[index.fieldOffset(i) - (i > 0 ? 1 : 0)], i > 0 ? '|' : '8');
+    }
+
+    ASSERT_NE(index.find(58), nullptr);
+    ASSERT_EQ(index.find(49), nullptr);
+
+    // The last field does not need to be terminated
+    ASSERT_TRUE(index.build(frame, std::strlen(frame) - 1));
+    ASSERT_EQ(index.size(), 6);
+
+    const char* malformed = "8=FIX.4.2|9=25|3A5=A|10=016|";
+    ASSERT_FALSE(index.build(malformed, std::strlen(malformed)));
+    ASSERT_EQ(index.errorOffset(), 15);
+
+    const char* missingValue = "8=FIX.4.2|9=25|35|10=016|";
+    ASSERT_FALSE(index.build(missingValue, std::strlen(missingValue)));
+}
+
+TEST(visitor_test, should_visit_indexed_frames)
+{
+    using VisitRules42 = DefaultTestRules<Fixpp::v42::Spec::Dictionary>;
+
+    const char* logon = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    auto logonErr = doVisitIndexed(logon, should_visit_logon_frame::Visitor(), should_visit_logon_frame::VisitRules());
+    ASSERT_TRUE(logonErr.isOk());
+
+    const char* group = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221";
+    auto groupErr = doVisitIndexed(group, should_visit_repeating_group_in_logon_frame::Visitor(), should_visit_repeating_group_in_logon_frame::VisitRules());
+    ASSERT_TRUE(groupErr.isOk());
+
+    auto value = doVisitIndexed(group, should_be_able_to_return_value_in_visitor::Visitor(), should_be_able_to_return_value_in_visitor::VisitRules());
+    ASSERT_EQ(value.unwrapOr(0), 10);
+
+    const char* nested = "8=FIX.4.4|9=0206|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
+                         "711=1|"
+                             "311=AUD/CAD|"
+                             "457=1|"
+                                 "458=TESTID|459=TESTSOURCE|"
+                             "462=1|"
+                         "292=D|268=2|"
+                             "269=0|271=500000|272=20170103|299=02z00000hdi:A|"
+                             "269=1|271=500000|272=20170103|299=02z00000hdi:A|"
+                         "10=019";
+    auto nestedErr = doVisitIndexed(nested, should_visit_nested_repeating_groups::Visitor(), should_visit_nested_repeating_groups::VisitRules());
+    ASSERT_TRUE(nestedErr.isOk());
+
+    const char* empty = "8=FIX.4.4|9=0048|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|268=0|10=187";
+    auto emptyErr = doVisitIndexed(empty, should_visit_empty_repeating_group::Visitor(), should_visit_empty_repeating_group::VisitRules());
+    ASSERT_TRUE(emptyErr.isOk());
+
+    const char* unknown = "8=FIX.4.4|9=0290|35=W|49=Prov|56=MDABC|55=AUD/CAD|262=1709|"
+                          "10721=CUSTOM1|"
+                          "711=1|"
+                              "311=AUD/CAD|"
+                              "10541=CUSTOM2|"
+                              "457=1|"
+                                  "458=TESTID|459=TESTSOURCE|10872=CUSTOM3|10873=CUSTOM4|"
+                              "462=1|"
+                          "292=D|268=2|"
+                              "269=0|271=500000|272=20170103|299=02z00000hdi:A|10331=CUSTOM5|"
+                              "269=1|271=500000|272=20170103|299=02z00000hdi:A|10331=CUSTOM6|"
+                          "10=174";
+    auto unknownErr = doVisitIndexed(unknown, should_visit_unknown_tags_in_non_strict_mode::Visitor(), should_visit_unknown_tags_in_non_strict_mode::VisitRules());
+    ASSERT_TRUE(unknownErr.isOk());
+
+    const char* invalidChecksum = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+    auto checksumErr = doVisitIndexed(invalidChecksum, AssertVisitor(), VisitRules42());
+    ASSERT_FALSE(checksumErr.isOk());
+    ASSERT_EQ(checksumErr.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    const char* noChecksum = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|";
+    auto missingErr = doVisitIndexed(noChecksum, AssertVisitor(), ChecksumOnlyTestRules());
+    ASSERT_FALSE(missingErr.isOk());
+    ASSERT_EQ(missingErr.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    const char* invalidLength = "8=FIX.4.2|9=70|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    auto lengthErr = doVisitIndexed(invalidLength, AssertVisitor(), VisitRules42());
+    ASSERT_FALSE(lengthErr.isOk());
+    ASSERT_EQ(lengthErr.unwrapErr().type(), Fixpp::ErrorKind::InvalidLength);
+
+    const char* unknownTag = "8=FIX.4.2|9=0028|35=0|49=Prov|56=MDABC|221=A|10=126";
+    auto strictErr = doVisitIndexed(unknownTag, AssertVisitor(), AssertVisitRules());
+    ASSERT_FALSE(strictErr.isOk());
+    ASSERT_EQ(strictErr.unwrapErr().type(), Fixpp::ErrorKind::UnknownTag);
+
+    const char* unknownMessage = "8=FIX.4.2|9=0000|35=ZZ|49=Prov|56=MDABC|10=213";
+    auto messageErr = doVisitIndexed(unknownMessage, AssertVisitor(), AssertVisitRules());
+    ASSERT_FALSE(messageErr.isOk());
+    ASSERT_EQ(messageErr.unwrapErr().type(), Fixpp::ErrorKind::UnknownMessage);
+
+    const char* malformed = "8=FIX.4.2|9=0022|35=0|4A9=Prov|56=MDABC|10=233";
+    auto malformedErr = doVisitIndexed(malformed, AssertVisitor(), AssertVisitRules());
+    ASSERT_FALSE(malformedErr.isOk());
+    ASSERT_EQ(malformedErr.unwrapErr().type(), Fixpp::ErrorKind::ParsingError);
+}
+
+TEST(visitor_test, should_visit_tag_in_index)
+{
+    const char* frame = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221|";
+
+    Fixpp::FieldIndex index;
+    ASSERT_TRUE(index.build(frame, std::strlen(frame)));
+
+    auto assertFalse = [&](const Fixpp::ErrorKind&) { ASSERT_TRUE(false); };
+
+    Fixpp::visitTag<Fixpp::Tag::RefMsgType>(index)
+        .then([&](const std::string& ref) { ASSERT_EQ(ref, "TEST"); })
+        .otherwise(assertFalse);
+
+    Fixpp::visitTag<Fixpp::Tag::BodyLength>(index)
+        .then([&](int64_t length) { ASSERT_EQ(length, 92); })
+        .otherwise(assertFalse);
+
+    Fixpp::visitTag<Fixpp::Tag::OnBehalfOfCompID>(index)
+        .then([&](const std::string&) { ASSERT_TRUE(false); })
+        .otherwise([&](const Fixpp::ErrorKind& e) { ASSERT_EQ(e.type(), Fixpp::ErrorKind::UnknownTag); });
+
+    // The same index can be visited many times
+    should_visit_repeating_group_in_logon_frame::Visitor visitor;
+    auto first = Fixpp::visitIndex(index, visitor, should_visit_repeating_group_in_logon_frame::VisitRules());
+    ASSERT_TRUE(first.isOk());
+
+    auto second = Fixpp::visitIndex(index, visitor, should_visit_repeating_group_in_logon_frame::VisitRules());
+    ASSERT_TRUE(second.isOk());
+}
+
+TEST(visitor_test, should_visit_many_tags_in_a_single_pass)
+{
+    const char* frame = "8=FIX.4.2|9=0225|35=S|49=FIXPROV|56=TRGT|34=1579321|52=20161230-11:05:36.052|115=TRGT|142=MRS|55=ZAR/JPY|60=20161230-11:05:36.052|63=0|64=20170105|117=d20052s3866|131=1276|132=8.525|133=8.547|134=1000000|135=1000000|303=2|537=1|11325=0|10=087";
+    const size_t size = std::strlen(frame);
+
+    using namespace Fixpp;
+
+    auto values = visitTags<Tag::MsgType, Tag::SenderCompID, Tag::MsgSeqNum, Tag::Symbol>(frame, size);
+    ASSERT_TRUE(values.isOk());
+
+    auto tags = values.unwrap();
+    ASSERT_EQ(*std::get<0>(tags), "S");
+    ASSERT_EQ(*std::get<1>(tags), "FIXPROV");
+    ASSERT_EQ(*std::get<2>(tags), 1579321);
+    ASSERT_EQ(*std::get<3>(tags), "ZAR/JPY");
+
+    // Missing tags are empty, the unterminated CheckSum is found
+    auto views = visitTagViews<Tag::DeliverToCompID, Tag::CheckSum>(frame, size);
+    ASSERT_TRUE(views.isOk());
+
+    auto checksum = views.unwrap();
+    ASSERT_FALSE(std::get<0>(checksum).has_value());
+    ASSERT_EQ(std::string(std::get<1>(checksum)->first, std::get<1>(checksum)->second), "087");
+
+    // The first occurence of a tag wins
+    const char* group = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST2|10=221|";
+    auto refMsgType = visitTags<Tag::RefMsgType>(group, std::strlen(group));
+    ASSERT_EQ(*std::get<0>(refMsgType.unwrap()), "TEST");
+
+    // Malformed values are empty
+    const char* garbled = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120399-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=077";
+    auto sendingTime = visitTags<Tag::SendingTime, Tag::MsgSeqNum>(garbled, std::strlen(garbled));
+    ASSERT_FALSE(std::get<0>(sendingTime.unwrap()).has_value());
+    ASSERT_EQ(*std::get<1>(sendingTime.unwrap()), 1);
+
+    const char* malformed = "8=FIX.4.2|9=0022|35=0|A49=Prov|56=MDABC|10=233";
+    auto error = visitTags<Tag::SenderCompID, Tag::TargetCompID>(malformed, std::strlen(malformed));
+    ASSERT_FALSE(error.isOk());
+    ASSERT_EQ(error.unwrapErr().type(), ErrorKind::ParsingError);
+
+    FieldIndex index;
+    ASSERT_TRUE(index.build(frame, size));
+
+    auto indexed = visitTags<Tag::MsgType, Tag::MsgSeqNum, Tag::DeliverToCompID>(index);
+    ASSERT_EQ(*std::get<0>(indexed), "S");
+    ASSERT_EQ(*std::get<1>(indexed), 1579321);
+    ASSERT_FALSE(std::get<2>(indexed).has_value());
+}
+
+TEST(visitor_test, should_visit_header_only)
+{
+    using namespace Fixpp;
+    using Dictionary = v42::Spec::Dictionary;
+
+    const char* frame = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068|";
+
+    auto result = visitHeader<Dictionary>(frame, std::strlen(frame));
+    ASSERT_TRUE(result.isOk());
+
+    auto headerFrame = result.unwrap();
+    ASSERT_EQ(get<Tag::MsgSeqNum>(headerFrame.header), 1);
+    ASSERT_EQ(get<Tag::SenderCompID>(headerFrame.header), "ABC");
+    ASSERT_EQ(get<Tag::TargetCompID>(headerFrame.header), "TT_ORDER");
+    ASSERT_EQ(std::string(headerFrame.msgType.first, headerFrame.msgType.second), "A");
+    ASSERT_EQ(headerFrame.bodyLength, 80);
+    ASSERT_EQ(std::string(frame + headerFrame.bodyOffset, headerFrame.bodySize), "96=12345678|98=0|108=60|141=Y|");
+
+    // Without BodyLength validation, the trailer is located from the end of the frame
+    auto checksumOnly = visitHeader(frame, std::strlen(frame), ChecksumOnlyTestRules());
+    ASSERT_TRUE(checksumOnly.isOk());
+    ASSERT_EQ(checksumOnly.unwrap().bodySize, headerFrame.bodySize);
+
+    // A frame without body
+    const char* heartbeat = "8=FIX.4.2|9=0022|35=0|49=Prov|56=MDABC|10=233";
+    auto heartbeatResult = visitHeader<Dictionary>(heartbeat, std::strlen(heartbeat));
+    ASSERT_TRUE(heartbeatResult.isOk());
+    ASSERT_EQ(heartbeatResult.unwrap().bodySize, 0);
+    ASSERT_EQ(std::string(heartbeat + heartbeatResult.unwrap().bodyOffset), "10=233");
+
+    const char* invalidChecksum = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+    auto checksumError = visitHeader<Dictionary>(invalidChecksum, std::strlen(invalidChecksum));
+    ASSERT_FALSE(checksumError.isOk());
+    ASSERT_EQ(checksumError.unwrapErr().type(), ErrorKind::InvalidChecksum);
+
+    auto noLengthError = visitHeader(invalidChecksum, std::strlen(invalidChecksum), ChecksumOnlyTestRules());
+    ASSERT_FALSE(noLengthError.isOk());
+    ASSERT_EQ(noLengthError.unwrapErr().type(), ErrorKind::InvalidChecksum);
+
+    const char* invalidLength = "8=FIX.4.2|9=70|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    auto lengthError = visitHeader<Dictionary>(invalidLength, std::strlen(invalidLength));
+    ASSERT_FALSE(lengthError.isOk());
+    ASSERT_EQ(lengthError.unwrapErr().type(), ErrorKind::InvalidLength);
+
+    auto versionError = visitHeader<v44::Spec::Dictionary>(frame, std::strlen(frame));
+    ASSERT_FALSE(versionError.isOk());
+    ASSERT_EQ(versionError.unwrapErr().type(), ErrorKind::InvalidVersion);
+}
+
+TEST(visitor_test, should_visit_projected_fields)
+{
+    using namespace should_visit_projected_fields;
+
+    const char* logon = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=068";
+    const char* invalidChecksum = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=248";
+
+    auto projected = doVisit(logon, Visitor(), VisitRules());
+    ASSERT_TRUE(projected.isOk());
+    ASSERT_EQ(projected.unwrap(), 1);
+
+    auto visitorProjection = doVisit(logon, ProjectedVisitor(), VisitRules());
+    ASSERT_TRUE(visitorProjection.isOk());
+    ASSERT_EQ(visitorProjection.unwrap(), -2);
+
+    // Parsing stops right after HeartBtInt, the CheckSum is still validated
+    auto stopped = doVisit(logon, Visitor(), StopRules());
+    ASSERT_TRUE(stopped.isOk());
+    ASSERT_EQ(stopped.unwrap(), 1);
+
+    auto stoppedError = doVisit(invalidChecksum, Visitor(), StopRules());
+    ASSERT_FALSE(stoppedError.isOk());
+    ASSERT_EQ(stoppedError.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    auto stoppedNoLength = doVisit(logon, Visitor(), ChecksumOnlyStopRules());
+    ASSERT_TRUE(stoppedNoLength.isOk());
+
+    auto stoppedNoLengthError = doVisit(invalidChecksum, Visitor(), ChecksumOnlyStopRules());
+    ASSERT_FALSE(stoppedNoLengthError.isOk());
+    ASSERT_EQ(stoppedNoLengthError.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+
+    const char* group = "8=FIX.4.2|9=92|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|10=221";
+    auto groupErr = doVisit(group, should_visit_repeating_group_in_logon_frame::Visitor(), GroupRules());
+    ASSERT_TRUE(groupErr.isOk());
+
+    // Indexed frames are resolved by the same MessageVisitor and honor the Projection as well
+    auto indexed = doVisitIndexed(logon, Visitor(), VisitRules());
+    ASSERT_TRUE(indexed.isOk());
+    ASSERT_EQ(indexed.unwrap(), 1);
+
+    auto indexedStopped = doVisitIndexed(invalidChecksum, Visitor(), ChecksumOnlyStopRules());
+    ASSERT_FALSE(indexedStopped.isOk());
+    ASSERT_EQ(indexedStopped.unwrapErr().type(), Fixpp::ErrorKind::InvalidChecksum);
+}
+
+TEST(visitor_test, should_reuse_messages)
+{
+    using namespace should_reuse_messages;
+
+    const char* group = "8=FIX.4.2|9=106|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST|108=30|9999=X|10=179|";
+    const char* logon = "8=FIX.4.2|9=88|35=A|34=1|49=DEF|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=1|372=TEST|98=0|141=Y|10=187|";
+
+    Visitor visitor;
+    ASSERT_TRUE(Fixpp::visit(group, std::strlen(group), visitor, VisitRules()).isOk());
+    ASSERT_TRUE(Fixpp::visit(logon, std::strlen(logon), visitor, VisitRules()).isOk());
+
+    // The same Refs are handed out for both frames and are reset in between
+    ASSERT_EQ(visitor.headers[0], visitor.headers[1]);
+    ASSERT_EQ(visitor.logons[0], visitor.logons[1]);
+
+    ASSERT_EQ(visitor.heartBtInts, (std::vector<int> { 30, -1 }));
+    ASSERT_EQ(visitor.msgTypes, (std::vector<size_t> { 2, 1 }));
+    ASSERT_EQ(visitor.unparsed, (std::vector<size_t> { 1, 0 }));
+
+    // A nested visit gets its own Refs
+    visitor.nested = logon;
+    ASSERT_TRUE(Fixpp::visit(group, std::strlen(group), visitor, VisitRules()).isOk());
+    ASSERT_EQ(visitor.logons.size(), 4);
+    ASSERT_EQ(visitor.logons[2], visitor.logons[0]);
+    ASSERT_NE(visitor.logons[3], visitor.logons[0]);
+}
+
+TEST(visitor_test, should_index_tag_set_densely)
+{
+    using CustomTag = Fixpp::TagT<11325, Fixpp::Type::Int>;
+    using Set = Fixpp::impl::TagSet<Fixpp::Tag::Symbol, Fixpp::Tag::BidPx, CustomTag>;
+
+    // One bit per tag, whatever the magnitude of the tags
+    static_assert(Set::Size == 3, "");
+    static_assert(sizeof(Set) <= sizeof(uint64_t), "");
+
+    Set set;
+    ASSERT_TRUE(set.valid(55));
+    ASSERT_TRUE(set.valid(132));
+    ASSERT_TRUE(set.valid(11325));
+    ASSERT_FALSE(set.valid(56));
+    ASSERT_FALSE(set.valid(11326));
+    ASSERT_FALSE(set.valid(100000));
+
+    set.set(11325);
+    ASSERT_TRUE(set.test(11325));
+    ASSERT_FALSE(set.test(55));
+
+    set.setAt(static_cast<size_t>(Set::index(55)));
+    ASSERT_TRUE(set.test(55));
+
+    set.reset();
+    ASSERT_FALSE(set.test(55));
+    ASSERT_FALSE(set.test(11325));
+}
+
+TEST(visitor_test, should_view_repeating_group_instances)
+{
+    const char* frame = "8=FIX.4.2|9=391|35=X|34=002565204|52=20160908-08:42:10.359|49=Prov|56=MDABC|262=1364|268=4|"
+                        "279=2|55=CHF/JPY|269=0|278=0453665272|270=00104.840000|271=001000000.00|15=CHF|"
+                        "279=0|55=CHF/JPY|269=0|278=0453665276|270=00104.841000|271=001000000.00|15=CHF|"
+                        "279=2|55=CHF/JPY|269=1|278=0453665273|270=00104.855000|271=001000000.00|15=CHF|"
+                        "279=0|55=CHF/JPY|269=1|278=0453665277|270=00104.856000|271=001000000.00|15=CHF|"
+                        "10=183";
+
+    using namespace should_view_repeating_group_instances;
+
+    auto err = doVisit(frame, Visitor(), VisitRules());
+    ASSERT_TRUE(err.isOk());
+}
+
+TEST(visitor_test, should_visit_with_arena)
+{
+    using namespace should_visit_with_arena;
+
+    const auto frame = makeFrame(32);
+
+    alignas(std::max_align_t) static char buffer[64 * 1024];
+    auto inBuffer = [&](const void* ptr) {
+        return ptr >= static_cast<const void*>(buffer) && ptr < static_cast<const void*>(buffer + sizeof buffer);
+    };
+
+    Fixpp::Arena arena(buffer, sizeof buffer, std::pmr::null_memory_resource());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        Visitor visitor;
+        ASSERT_TRUE(Fixpp::visit(frame.data(), frame.size(), visitor, VisitRules(), arena).isOk());
+
+        ASSERT_EQ(visitor.instances, 32);
+        ASSERT_EQ(visitor.lastMsgType, "T31");
+        ASSERT_EQ(visitor.unparsed, 32);
+
+        // Storage that outgrows the inline storage comes from the Arena...
+        ASSERT_TRUE(inBuffer(visitor.groupStorage));
+        ASSERT_TRUE(inBuffer(visitor.unparsedStorage));
+
+        // ... but copies live on the heap
+        auto copy = Fixpp::get<Fixpp::Tag::NoMsgTypes>(*visitor.copy);
+        ASSERT_EQ(copy.size(), 32);
+        ASSERT_FALSE(inBuffer(copy.begin()));
+        ASSERT_FALSE(inBuffer(visitor.copy->unparsed.data()));
+
+        // The Arena is only used by the parsing, not by the visitor
+        ASSERT_EQ(visitor.grown.size(), 16);
+        ASSERT_FALSE(inBuffer(visitor.grown.data()));
+    }
+
+    // Without an Arena, storage comes from the heap
+    Visitor visitor;
+    ASSERT_TRUE(Fixpp::visit(frame.data(), frame.size(), visitor, VisitRules()).isOk());
+    ASSERT_FALSE(inBuffer(visitor.groupStorage));
+
+    // Exhausting an Arena without upstream resource throws
+    char small[256];
+    Fixpp::Arena exhausted(small, sizeof small, std::pmr::null_memory_resource());
+    ASSERT_THROW(Fixpp::visit(frame.data(), frame.size(), visitor, VisitRules(), exhausted), std::bad_alloc);
+
+    // The heap is used as a fallback by default
+    Fixpp::Arena fallback(small, sizeof small);
+    ASSERT_TRUE(Fixpp::visit(frame.data(), frame.size(), visitor, VisitRules(), fallback).isOk());
+    ASSERT_EQ(visitor.instances, 32);
+}
+
+TEST(visitor_test, should_view_string_fields)
+{
+    using namespace should_view_string_fields;
+
+    const std::string frame = "8=FIX.4.2|9=93|35=A|34=1|49=ABC|52=20120309-16:54:02|56=TT_ORDER|96=12345678|384=2|372=TEST|385=C|372=TEST2|10=016";
+
+    Visitor visitor(frame);
+    auto err = Fixpp::visit(frame.data(), frame.size(), visitor, VisitRules());
+    ASSERT_TRUE(err.isOk()) << err.unwrapErr().asString();
+}
+
+TEST(visitor_test, should_not_get_malformed_time_fields)
+{
+    using namespace should_not_get_malformed_time_fields;
+
+    const char* frame = "8=FIX.4.2|9=80|35=A|34=1|49=ABC|52=20120399-16:54:02|56=TT_ORDER|96=12345678|98=0|108=60|141=Y|10=077";
+
+    auto err = doVisit(frame, Visitor(), VisitRules());
+    ASSERT_TRUE(err.isOk()) << err.unwrapErr().asString();
+}
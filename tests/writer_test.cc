@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 
@@ -185,6 +186,67 @@ TEST(writer_test, should_write_utc_timestamp_field_with_microseconds)
     ASSERT_EQ(oss.str(), "52=20170516-13:45:30.123456|");
 }
 
+TEST(writer_test, should_write_utc_timestamp_field_with_nanoseconds)
+{
+    using Field = Fixpp::Field<Fixpp::Tag::SendingTime>;
+    Field field;
+
+    const auto timePoint = std::chrono::system_clock::time_point(std::chrono::seconds(1494942330)) + std::chrono::nanoseconds(123456789);
+    field.set(Fixpp::Type::UTCTimestamp::Time{timePoint});
+
+    std::ostringstream oss;
+    writeField(oss, field);
+
+    ASSERT_EQ(oss.str(), "52=20170516-13:45:30.123456789|");
+
+    // Truncating the timestamp lowers its precision
+    field.set(Fixpp::Type::UTCTimestamp::Time{std::chrono::floor<std::chrono::milliseconds>(timePoint)});
+
+    std::ostringstream truncated;
+    writeField(truncated, field);
+
+    ASSERT_EQ(truncated.str(), "52=20170516-13:45:30.123|");
+}
+
+TEST(writer_test, should_write_utc_timestamp_field_with_its_precision)
+{
+    using Field = Fixpp::Field<Fixpp::Tag::SendingTime>;
+    Field field;
+
+    std::tm tm{};
+    tm.tm_year = 117;
+    tm.tm_mon = 4;
+    tm.tm_mday = 16;
+    tm.tm_hour = 13;
+    tm.tm_min = 45;
+    tm.tm_sec = 30;
+
+    // Explicit milliseconds are written even when they are zero
+    field.set(Fixpp::Type::UTCTimestamp::Time{mkgmtime(&tm), 0});
+
+    std::ostringstream oss;
+    writeField(oss, field);
+
+    ASSERT_EQ(oss.str(), "52=20170516-13:45:30.000|");
+
+    // Parsed timestamps are written back with the same number of digits
+    for (std::string value: { "20170516-13:45:30", "20170516-13:45:30.000", "20170516-13:45:30.100000", "20170516-13:45:30.000000000" })
+    {
+        Fixpp::Type::UTCTimestamp::Time time;
+        ASSERT_TRUE(Fixpp::details::LexicalCast<Fixpp::Type::UTCTimestamp>::tryCast(value.data(), value.size(), &time));
+        field.set(time);
+
+        std::ostringstream roundTrip;
+        writeField(roundTrip, field);
+        ASSERT_EQ(roundTrip.str(), "52=" + value + "|");
+
+        char buffer[64];
+        Fixpp::details::FrameBuffer buf(buffer, buffer + sizeof buffer);
+        Fixpp::details::FieldFormatter<Field>::write(buf, field);
+        ASSERT_EQ(std::string(buffer, buf.size()), "52=" + value + "|");
+    }
+}
+
 TEST(writer_test, should_write_int_field)
 {
     using Field = Fixpp::Field<Fixpp::Tag::MsgSeqNum>;
@@ -333,3 +395,96 @@ TEST(writer_test, should_write_nested_repeating_groups)
     Fixpp::Writer writer;
     std::cout << writer.write(header, snapshot) << std::endl;
 }
+
+template<typename Header, typename Message>
+void checkBuffer(const Header& header, const Message& message)
+{
+    Fixpp::Writer writer;
+    const auto expected = writer.write(header, message);
+
+    char buffer[1024];
+    const size_t size = writer.write(header, message, buffer, sizeof buffer);
+
+    ASSERT_EQ(std::string(buffer, size), expected);
+
+    // The frame must fit entirely, its CheckSum included
+    ASSERT_EQ(writer.write(header, message, buffer, expected.size()), expected.size());
+    ASSERT_EQ(writer.write(header, message, buffer, expected.size() - 1), 0);
+    ASSERT_EQ(writer.write(header, message, buffer, 8), 0);
+}
+
+TEST(writer_test, should_write_into_buffer)
+{
+    Fixpp::v42::Message::Heartbeat heartbeat;
+    Fixpp::set<Fixpp::Tag::TestReqID>(heartbeat, "TestReq");
+
+    checkBuffer(createHeader<Fixpp::v42::Header>(), heartbeat);
+
+    Fixpp::v42::Message::NewOrderSingle order;
+    Fixpp::set<Fixpp::Tag::ClOrdID>(order, "ord1-50000");
+    Fixpp::set<Fixpp::Tag::Symbol>(order, "BHP");
+    Fixpp::set<Fixpp::Tag::Side>(order, '1');
+    Fixpp::set<Fixpp::Tag::HandlInst>(order, '1');
+    Fixpp::set<Fixpp::Tag::OrdType>(order, '2');
+    Fixpp::set<Fixpp::Tag::OrderQty>(order, 1500.0);
+    Fixpp::set<Fixpp::Tag::Price>(order, 17.35);
+    Fixpp::set<Fixpp::Tag::LocateReqd>(order, true);
+
+    const auto timePoint = std::chrono::system_clock::time_point(std::chrono::seconds(1494942330)) + std::chrono::nanoseconds(123456789);
+    Fixpp::set<Fixpp::Tag::TransactTime>(order, Fixpp::Type::UTCTimestamp::Time{timePoint});
+
+    auto header = createHeader<Fixpp::v42::Header>();
+    Fixpp::set<Fixpp::Tag::SendingTime>(header, Fixpp::Type::UTCTimestamp::Time{std::chrono::floor<std::chrono::milliseconds>(timePoint)});
+
+    checkBuffer(header, order);
+
+#if defined(__cpp_lib_span)
+    std::array<char, 512> buffer;
+    const size_t size = Fixpp::Writer().write(header, order, std::span<char>(buffer));
+    ASSERT_EQ(std::string(buffer.data(), size), Fixpp::Writer().write(header, order));
+#endif
+}
+
+TEST(writer_test, should_write_repeating_groups_into_buffer)
+{
+    Fixpp::v44::Message::MarketDataSnapshot snapshot;
+    Fixpp::set<Fixpp::Tag::MDReqID>(snapshot, "1709");
+    Fixpp::set<Fixpp::Tag::Symbol>(snapshot, "AUD/CAD");
+
+    auto underlyings = Fixpp::createGroup<Fixpp::Tag::NoUnderlyings>(snapshot, 1);
+    auto underlying = underlyings.instance();
+    Fixpp::set<Fixpp::Tag::UnderlyingProduct>(underlying, 1);
+
+    auto altIDs = Fixpp::createGroup<Fixpp::Tag::NoUnderlyingSecurityAltID>(underlying, 1);
+    auto altID = altIDs.instance();
+    Fixpp::set<Fixpp::Tag::UnderlyingSecurityAltID>(altID, "TESTID");
+    altIDs.add(altID);
+    underlyings.add(underlying);
+
+    std::tm entryDateTm{};
+    entryDateTm.tm_year = 117;
+    entryDateTm.tm_mon = 4;
+    entryDateTm.tm_mday = 16;
+
+    std::tm entryTimeTm{};
+    entryTimeTm.tm_hour = 15;
+    entryTimeTm.tm_min = 10;
+    entryTimeTm.tm_sec = 5;
+
+    auto mdEntries = Fixpp::createGroup<Fixpp::Tag::NoMDEntries>(snapshot, 2);
+    auto mdEntry0 = mdEntries.instance();
+    Fixpp::set<Fixpp::Tag::MDEntryType>(mdEntry0, '0');
+    Fixpp::set<Fixpp::Tag::MDEntryPx>(mdEntry0, 0.000012345);
+    Fixpp::set<Fixpp::Tag::MDEntrySize>(mdEntry0, 1e20);
+    Fixpp::set<Fixpp::Tag::MDEntryDate>(mdEntry0, Fixpp::Type::UTCDate::Date{mkgmtime(&entryDateTm)});
+    Fixpp::set<Fixpp::Tag::MDEntryTime>(mdEntry0, Fixpp::Type::UTCTimeOnly::Time{mkgmtime(&entryTimeTm), 100, 7});
+    mdEntries.add(mdEntry0);
+
+    auto mdEntry1 = mdEntries.instance();
+    Fixpp::set<Fixpp::Tag::MDEntryType>(mdEntry1, '1');
+    Fixpp::set<Fixpp::Tag::MDEntryPx>(mdEntry1, -1234567.45);
+    Fixpp::set<Fixpp::Tag::MDEntryTime>(mdEntry1, Fixpp::Type::UTCTimeOnly::Time{mkgmtime(&entryTimeTm), 100});
+    mdEntries.add(mdEntry1);
+
+    checkBuffer(createHeader<Fixpp::v44::Header>(), snapshot);
+}